@@ -0,0 +1,472 @@
+/**
+ * ============================================================
+ *  LATÊNCIA DE INTERRUPÇÕES DE SOFTWARE E TEMPORIZADORES (Linux)
+ *  ------------------------------------------------------------
+ *  Versão medida de Interruption/software-interruption.py
+ *  Autor: Gabriel Rozendo
+ * ============================================================
+ *
+ *  O script em Python simula uma interrupção de hardware com uma
+ *  thread temporizada e uma interrupção de software com SIGINT.
+ *  Aqui medimos os mecanismos reais que um daemon usa para ser
+ *  "interrompido":
+ *
+ *   • sigqueue → handler   : sinal de tempo real entregue a um
+ *                            handler SA_SIGINFO (assíncrono).
+ *   • sigqueue → signalfd  : o mesmo sinal consumido por read()
+ *                            em um signalfd (síncrono).
+ *   • eventfd              : write() em uma thread acorda read()
+ *                            bloqueado em outra.
+ *   • timerfd              : jitter de um temporizador periódico
+ *                            (atraso entre o vencimento e o despertar).
+ *   • timer POSIX          : timer_create + SIGEV_THREAD_ID,
+ *                            recebido com sigwaitinfo().
+ *
+ *  Cada teste roda ocioso e sob carga (uma thread ocupada por CPU)
+ *  e reporta a distribuição de latência: p50, p99, p99.9 e máximo.
+ *
+ *  Compilação:
+ *    g++ -std=c++17 -O2 -pthread Interruption/interrupt-latency.cpp -o Interruption/interrupt_latency
+ * ============================================================
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// Sinais de tempo real: enfileirados, nunca coalescidos
+#define SINAL_HANDLER   (SIGRTMIN)
+#define SINAL_SIGNALFD  (SIGRTMIN + 1)
+#define SINAL_TIMER     (SIGRTMIN + 2)
+
+// glibc antiga não expõe o campo do SIGEV_THREAD_ID
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+// =============================================================
+// Utilitários
+// =============================================================
+
+inline uint64_t agora_ns() {
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000ull + (uint64_t)t.tv_nsec;
+}
+
+[[noreturn]] void falhar(const char *msg) {
+    perror(msg);
+    exit(EXIT_FAILURE);
+}
+
+// Espera até um instante absoluto (ritmo do emissor, sem acumular deriva)
+void dormir_ate(uint64_t instante_ns) {
+    timespec t;
+    t.tv_sec = (time_t)(instante_ns / 1000000000ull);
+    t.tv_nsec = (long)(instante_ns % 1000000000ull);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, nullptr) == EINTR) {
+    }
+}
+
+inline pid_t obter_tid() {
+    return (pid_t)syscall(SYS_gettid);
+}
+
+// Parâmetros comuns a todos os testes
+struct Config {
+    size_t amostras;
+    uint64_t intervalo_ns;
+};
+
+// =============================================================
+// Carga artificial — uma thread ocupada por CPU
+// =============================================================
+
+class Carga {
+public:
+    explicit Carga(unsigned threads) {
+        for (unsigned i = 0; i < threads; i++)
+            threads_.emplace_back([this] { ocupar(); });
+    }
+
+    ~Carga() {
+        parar_.store(true);
+        for (std::thread &t : threads_)
+            t.join();
+    }
+
+private:
+    // Mistura ALU e acessos a memória fora da cache
+    void ocupar() {
+        std::vector<uint64_t> buffer(1u << 20);
+        uint64_t x = 88172645463325252ull;
+        while (!parar_.load(std::memory_order_relaxed)) {
+            for (int i = 0; i < 4096; i++) {
+                x ^= x << 13;
+                x ^= x >> 7;
+                x ^= x << 17;
+                buffer[x & (buffer.size() - 1)] += x;
+            }
+        }
+    }
+
+    std::atomic<bool> parar_{false};
+    std::vector<std::thread> threads_;
+};
+
+// =============================================================
+// Envio de sinais com confirmação (testes 1 e 2)
+// =============================================================
+
+void confirmar(int confirmacao) {
+    uint64_t um = 1;
+    if (write(confirmacao, &um, sizeof(um)) != (ssize_t)sizeof(um))
+        falhar("write (confirmacao)");
+}
+
+// Um sinal por vez: o próximo só sai depois que o receptor confirma o anterior.
+// Sem isso, um receptor atrasado acumula sinais RT na fila e a amostra mede a
+// fila, não a entrega — e o eventfd, em ping-pong, deixaria de ser comparável.
+void enviar_sinais(const Config &cfg, pthread_t receptor, int sinal, int confirmacao) {
+    uint64_t proximo = agora_ns();
+    for (size_t i = 0; i < cfg.amostras; i++) {
+        proximo += cfg.intervalo_ns;
+        dormir_ate(proximo);
+        sigval v;
+        v.sival_ptr = (void *)(uintptr_t)agora_ns();
+        while (pthread_sigqueue(receptor, sinal, v) != 0) {
+            // EAGAIN: fila de sinais RT cheia (RLIMIT_SIGPENDING) — tenta de novo
+            std::this_thread::yield();
+        }
+        uint64_t ok;
+        while (read(confirmacao, &ok, sizeof(ok)) != (ssize_t)sizeof(ok))
+            if (errno != EINTR)
+                falhar("read (confirmacao)");
+        if (agora_ns() > proximo)
+            proximo = agora_ns();   // não acumula envios atrasados em rajada
+    }
+}
+
+// =============================================================
+// Teste 1: sigqueue → handler SA_SIGINFO
+// =============================================================
+
+static uint64_t *g_amostras = nullptr;
+static std::atomic<size_t> g_recebidos{0};
+static int g_confirmacao = -1;
+
+// Só usa operações async-signal-safe: clock_gettime, atômicos sem trava e write()
+void handler_sinal(int, siginfo_t *info, void *) {
+    uint64_t chegada = agora_ns();
+    size_t i = g_recebidos.load(std::memory_order_relaxed);
+    g_amostras[i] = chegada - (uint64_t)(uintptr_t)info->si_value.sival_ptr;
+    g_recebidos.store(i + 1, std::memory_order_release);
+    uint64_t um = 1;
+    if (write(g_confirmacao, &um, sizeof(um)) != (ssize_t)sizeof(um))
+        _exit(EXIT_FAILURE);
+}
+
+std::vector<uint64_t> medir_sigqueue_handler(const Config &cfg) {
+    std::vector<uint64_t> amostras(cfg.amostras);
+    std::atomic<pthread_t> receptor{};
+    std::atomic<bool> pronto{false};
+
+    g_amostras = amostras.data();
+    g_recebidos.store(0);
+    g_confirmacao = eventfd(0, 0);
+    if (g_confirmacao < 0)
+        falhar("eventfd");
+
+    struct sigaction sa {};
+    sa.sa_sigaction = handler_sinal;
+    sa.sa_flags = SA_SIGINFO;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SINAL_HANDLER, &sa, nullptr);
+
+    std::thread t([&] {
+        receptor.store(pthread_self());
+        pronto.store(true);
+
+        // O sinal fica bloqueado fora do sigsuspend: sem corrida entre o teste e a espera
+        sigset_t espera;
+        pthread_sigmask(SIG_BLOCK, nullptr, &espera);
+        sigdelset(&espera, SINAL_HANDLER);
+        while (g_recebidos.load(std::memory_order_acquire) < cfg.amostras)
+            sigsuspend(&espera);
+    });
+    while (!pronto.load())
+        std::this_thread::yield();
+
+    enviar_sinais(cfg, receptor.load(), SINAL_HANDLER, g_confirmacao);
+    t.join();
+    close(g_confirmacao);
+    return amostras;
+}
+
+// =============================================================
+// Teste 2: sigqueue → signalfd
+// =============================================================
+
+std::vector<uint64_t> medir_sigqueue_signalfd(const Config &cfg) {
+    std::vector<uint64_t> amostras(cfg.amostras);
+    std::atomic<pthread_t> receptor{};
+    std::atomic<bool> pronto{false};
+    int confirmacao = eventfd(0, 0);
+    if (confirmacao < 0)
+        falhar("eventfd");
+
+    std::thread t([&] {
+        sigset_t conjunto;
+        sigemptyset(&conjunto);
+        sigaddset(&conjunto, SINAL_SIGNALFD);
+        int sfd = signalfd(-1, &conjunto, 0);
+        if (sfd < 0)
+            falhar("signalfd");
+
+        receptor.store(pthread_self());
+        pronto.store(true);
+
+        for (size_t i = 0; i < cfg.amostras; i++) {
+            signalfd_siginfo info;
+            if (read(sfd, &info, sizeof(info)) != (ssize_t)sizeof(info))
+                falhar("read (signalfd)");
+            amostras[i] = agora_ns() - info.ssi_ptr;
+            confirmar(confirmacao);
+        }
+        close(sfd);
+    });
+    while (!pronto.load())
+        std::this_thread::yield();
+
+    enviar_sinais(cfg, receptor.load(), SINAL_SIGNALFD, confirmacao);
+    t.join();
+    close(confirmacao);
+    return amostras;
+}
+
+// =============================================================
+// Teste 3: eventfd — despertar de uma thread bloqueada
+// =============================================================
+
+std::vector<uint64_t> medir_eventfd(const Config &cfg) {
+    std::vector<uint64_t> amostras(cfg.amostras);
+    int efd = eventfd(0, 0);
+    int confirmacao = eventfd(0, 0);
+    if (efd < 0 || confirmacao < 0)
+        falhar("eventfd");
+
+    // Ping-pong: um só evento pendente por amostra, então os write() nunca se somam
+    // e o valor lido é o próprio instante de envio (o payload de 8 bytes do eventfd).
+    std::thread t([&] {
+        for (size_t i = 0; i < cfg.amostras; i++) {
+            uint64_t enviado;
+            if (read(efd, &enviado, sizeof(enviado)) != (ssize_t)sizeof(enviado))
+                falhar("read (eventfd)");
+            amostras[i] = agora_ns() - enviado;
+            confirmar(confirmacao);
+        }
+    });
+
+    uint64_t proximo = agora_ns();
+    for (size_t i = 0; i < cfg.amostras; i++) {
+        proximo += cfg.intervalo_ns;
+        dormir_ate(proximo);
+        uint64_t enviado = agora_ns();
+        if (write(efd, &enviado, sizeof(enviado)) != (ssize_t)sizeof(enviado))
+            falhar("write (eventfd)");
+        uint64_t ok;
+        if (read(confirmacao, &ok, sizeof(ok)) != (ssize_t)sizeof(ok))
+            falhar("read (confirmacao)");
+        if (agora_ns() > proximo)
+            proximo = agora_ns();   // não acumula envios atrasados em rajada
+    }
+    t.join();
+    close(efd);
+    close(confirmacao);
+    return amostras;
+}
+
+// =============================================================
+// Teste 4: timerfd periódico — atraso entre vencimento e despertar
+// =============================================================
+
+std::vector<uint64_t> medir_timerfd(const Config &cfg) {
+    std::vector<uint64_t> amostras;
+    amostras.reserve(cfg.amostras);
+
+    int tfd = timerfd_create(CLOCK_MONOTONIC, 0);
+    if (tfd < 0)
+        falhar("timerfd_create");
+
+    uint64_t inicio = agora_ns() + cfg.intervalo_ns;
+    itimerspec t{};
+    t.it_value.tv_sec = (time_t)(inicio / 1000000000ull);
+    t.it_value.tv_nsec = (long)(inicio % 1000000000ull);
+    t.it_interval.tv_sec = (time_t)(cfg.intervalo_ns / 1000000000ull);
+    t.it_interval.tv_nsec = (long)(cfg.intervalo_ns % 1000000000ull);
+    if (timerfd_settime(tfd, TFD_TIMER_ABSTIME, &t, nullptr) < 0)
+        falhar("timerfd_settime");
+
+    // Vencimentos perdidos (overrun) contam como um despertar atrasado desde o mais antigo
+    uint64_t vencidos = 0;
+    while (amostras.size() < cfg.amostras) {
+        uint64_t expiracoes;
+        if (read(tfd, &expiracoes, sizeof(expiracoes)) != (ssize_t)sizeof(expiracoes))
+            falhar("read (timerfd)");
+        uint64_t chegada = agora_ns();
+        uint64_t previsto = inicio + vencidos * cfg.intervalo_ns;
+        amostras.push_back(chegada - previsto);
+        vencidos += expiracoes;
+    }
+    close(tfd);
+    return amostras;
+}
+
+// =============================================================
+// Teste 5: timer POSIX (timer_create) entregue por sinal à thread
+// =============================================================
+
+std::vector<uint64_t> medir_timer_posix(const Config &cfg) {
+    std::vector<uint64_t> amostras;
+    amostras.reserve(cfg.amostras);
+
+    std::thread t([&] {
+        sigset_t conjunto;
+        sigemptyset(&conjunto);
+        sigaddset(&conjunto, SINAL_TIMER);
+
+        sigevent ev {};
+        ev.sigev_notify = SIGEV_THREAD_ID;
+        ev.sigev_signo = SINAL_TIMER;
+        ev.sigev_notify_thread_id = obter_tid();
+        timer_t timer;
+        if (timer_create(CLOCK_MONOTONIC, &ev, &timer) < 0)
+            falhar("timer_create");
+
+        uint64_t inicio = agora_ns() + cfg.intervalo_ns;
+        itimerspec its{};
+        its.it_value.tv_sec = (time_t)(inicio / 1000000000ull);
+        its.it_value.tv_nsec = (long)(inicio % 1000000000ull);
+        its.it_interval.tv_sec = (time_t)(cfg.intervalo_ns / 1000000000ull);
+        its.it_interval.tv_nsec = (long)(cfg.intervalo_ns % 1000000000ull);
+        if (timer_settime(timer, TIMER_ABSTIME, &its, nullptr) < 0)
+            falhar("timer_settime");
+
+        // Um timer POSIX enfileira no máximo um sinal: os vencimentos extras viram overrun
+        uint64_t vencidos = 0;
+        while (amostras.size() < cfg.amostras) {
+            siginfo_t info;
+            if (sigwaitinfo(&conjunto, &info) < 0) {
+                if (errno == EINTR)
+                    continue;
+                falhar("sigwaitinfo");
+            }
+            uint64_t chegada = agora_ns();
+            amostras.push_back(chegada - (inicio + vencidos * cfg.intervalo_ns));
+            vencidos += 1 + (uint64_t)info.si_overrun;
+        }
+        timer_delete(timer);
+    });
+    t.join();
+    return amostras;
+}
+
+// =============================================================
+// Relatório
+// =============================================================
+
+void imprimir_linha(const char *teste, const char *condicao, std::vector<uint64_t> amostras) {
+    std::sort(amostras.begin(), amostras.end());
+    auto percentil = [&](double p) {
+        return (double)amostras[(size_t)(p * (double)(amostras.size() - 1))] / 1000.0;
+    };
+    double soma = 0;
+    for (uint64_t a : amostras)
+        soma += (double)a;
+    printf("%-20s | %-7s | %9.2f | %9.2f | %9.2f | %9.2f | %9.2f\n", teste, condicao,
+           soma / (double)amostras.size() / 1000.0, percentil(0.50), percentil(0.99), percentil(0.999),
+           (double)amostras.back() / 1000.0);
+}
+
+int main(int argc, char **argv) {
+    Config cfg;
+    cfg.amostras = argc > 1 ? strtoul(argv[1], nullptr, 10) : 20000;
+    cfg.intervalo_ns = (argc > 2 ? strtoull(argv[2], nullptr, 10) : 200) * 1000;
+    unsigned threads_carga = argc > 3 ? (unsigned)atoi(argv[3]) : std::thread::hardware_concurrency();
+    if (cfg.amostras == 0 || cfg.intervalo_ns == 0) {
+        fprintf(stderr, "Uso: %s [amostras] [intervalo_us] [threads_de_carga]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Todas as threads herdam os sinais RT bloqueados; cada receptor os consome explicitamente
+    sigset_t bloqueados;
+    sigemptyset(&bloqueados);
+    sigaddset(&bloqueados, SINAL_HANDLER);
+    sigaddset(&bloqueados, SINAL_SIGNALFD);
+    sigaddset(&bloqueados, SINAL_TIMER);
+    pthread_sigmask(SIG_BLOCK, &bloqueados, nullptr);
+
+    struct Teste {
+        const char *nome;
+        std::function<std::vector<uint64_t>(const Config &)> medir;
+    };
+    const Teste testes[] = {
+        {"sigqueue -> handler", medir_sigqueue_handler},
+        {"sigqueue -> signalfd", medir_sigqueue_signalfd},
+        {"eventfd", medir_eventfd},
+        {"timerfd (jitter)", medir_timerfd},
+        {"timer POSIX (jitter)", medir_timer_posix},
+    };
+
+    printf("============================================================\n");
+    printf("   LATÊNCIA DE SINAIS, TEMPORIZADORES E EVENTFD\n");
+    printf("============================================================\n");
+    printf("Amostras por teste : %zu\n", cfg.amostras);
+    printf("Intervalo          : %llu us\n", (unsigned long long)(cfg.intervalo_ns / 1000));
+    printf("Threads de carga   : %u\n\n", threads_carga);
+
+    printf("%-20s | %-7s | %9s | %9s | %9s | %9s | %9s\n", "Teste", "Estado", "media(us)", "p50 (us)",
+           "p99 (us)", "p99.9(us)", "max (us)");
+    printf("---------------------+---------+-----------+-----------+-----------+-----------+----------\n");
+
+    // Uma amostra perdida (eventos somados) enviesaria os percentis sem aviso
+    auto executar = [&](const Teste &t, const char *condicao) {
+        std::vector<uint64_t> amostras = t.medir(cfg);
+        if (amostras.size() != cfg.amostras) {
+            fprintf(stderr, "%s: %zu amostras, esperadas %zu\n", t.nome, amostras.size(), cfg.amostras);
+            exit(EXIT_FAILURE);
+        }
+        imprimir_linha(t.nome, condicao, amostras);
+    };
+
+    for (const Teste &t : testes)
+        executar(t, "ocioso");
+
+    {
+        Carga carga(threads_carga);
+        for (const Teste &t : testes)
+            executar(t, "carga");
+    }
+
+    printf("\nObservacao:\n");
+    printf("- handler: o kernel interrompe a thread e desvia para o handler (como uma IRQ).\n");
+    printf("- signalfd/eventfd: o evento vira E/S comum; a thread acorda de um read().\n");
+    printf("- Sob carga, a cauda (p99.9/max) reflete o escalonador, nao o mecanismo.\n");
+    return EXIT_SUCCESS;
+}
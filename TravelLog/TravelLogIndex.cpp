@@ -0,0 +1,616 @@
+/*
+ * log_viagens_indexado_win.c
+ * Log de viagens com consultas indexadas e leitura sem copia (zero-copy) no Windows (Win32 API).
+ *
+ * Diferente de TravelLog.cpp, que apenas despeja o arquivo texto em blocos de 255 bytes,
+ * este programa grava registros binarios de tamanho fixo em um arquivo de dados e mantem
+ * dois indices auxiliares (sidecar), atualizados a cada insercao:
+ *
+ *  - log_viagens_win.dat   -> registros de 64 bytes (somente anexados)
+ *  - log_viagens_win.hidx  -> indice hash por destino (cabecas das cadeias por bucket)
+ *  - log_viagens_win.kidx  -> indice ordenado por quilometragem (corridas ordenadas em
+ *                             niveis de tamanho 2^k, com chaves esparsas em memoria)
+ *
+ * Um indice ausente com registros ja gravados e reconstruido na abertura.
+ *
+ * As consultas percorrem os registros diretamente no segmento mapeado em memoria e
+ * entregam ponteiros para eles: nenhum texto e interpretado e nenhum registro e copiado.
+ *
+ * Operacoes principais:
+ *  - CreateFileA()        -> criar/abrir arquivos de dados e de indice
+ *  - CreateFileMappingA() -> criar (e crescer) o mapeamento do arquivo
+ *  - MapViewOfFile()      -> projetar o arquivo no espaco de enderecamento
+ *  - FlushViewOfFile()    -> forcar a gravacao das paginas alteradas
+ *  - UnmapViewOfFile()    -> desfazer o mapeamento
+ *  - CloseHandle()        -> fechar arquivos e mapeamentos
+ *
+ */
+
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+// Constantes
+#define DATA_FILE "log_viagens_win.dat"
+#define HASH_FILE "log_viagens_win.hidx"
+#define KM_FILE   "log_viagens_win.kidx"
+
+#define DESTINO_MAX 52               // inclui o '\0' final
+#define NUM_BUCKETS 65536            // potencia de 2 (mascara no lugar de modulo)
+#define RUN_BASE 1024                // entradas na cauda nao ordenada do indice de km
+#define MAX_NIVEIS 32                // nivel k guarda RUN_BASE << k entradas ordenadas
+#define PASSO_ESPARSO 64             // uma chave esparsa a cada 64 entradas
+#define CAPACIDADE_INICIAL 4096      // registros reservados no primeiro mapeamento
+#define NENHUM 0xFFFFFFFFu           // fim de cadeia no indice hash
+
+#define MAGIC_DADOS 0x56474F4Cu      // "LOGV"
+#define MAGIC_HASH  0x58444948u      // "HIDX"
+#define MAGIC_KM    0x58444B4Bu      // "KKDX"
+
+// Registro de viagem em disco: tamanho fixo para permitir acesso direto por indice
+typedef struct {
+    int32_t quilometragem;
+    float combustivel;
+    uint32_t proximo;                // proximo registro do mesmo bucket (cadeia do hash)
+    char destino[DESTINO_MAX];
+} RegistroViagem;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t tamanhoRegistro;
+    uint64_t total;                  // registros validos
+    uint8_t reservado[48];
+} CabecalhoDados;                    // 64 bytes: registros ficam alinhados
+
+typedef struct {
+    uint32_t magic;
+    uint32_t numBuckets;
+    uint32_t cabecas[NUM_BUCKETS];   // ultimo registro inserido em cada bucket
+} IndiceHash;
+
+typedef struct {
+    int32_t quilometragem;
+    uint32_t registro;
+} EntradaKm;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t qtdCauda;               // entradas ainda nao ordenadas
+    uint32_t niveisOcupados;         // bit k = nivel k contem RUN_BASE << k entradas
+    uint32_t reservado;
+} CabecalhoKm;
+
+// Arquivo mapeado em memoria
+typedef struct {
+    HANDLE arquivo;
+    HANDLE mapeamento;
+    unsigned char *base;
+    uint64_t tamanho;
+} Segmento;
+
+// Chaves esparsas de um nivel (mantidas somente em memoria)
+typedef struct {
+    int32_t *chaves;
+    uint32_t qtd;
+} ChavesEsparsas;
+
+// Log indexado completo
+typedef struct {
+    Segmento dados;
+    Segmento hash;
+    Segmento km;
+    ChavesEsparsas esparsas[MAX_NIVEIS];
+} LogIndexado;
+
+// Funcao chamada para cada registro encontrado (ponteiro aponta para o mapeamento)
+typedef void (*VisitanteViagem)(const RegistroViagem *r, uint32_t indice, void *contexto);
+
+// Função para exibir erro padrao do Windows
+void mostrarErro(const char *mensagem) {
+    DWORD codigo = GetLastError();
+    printf("%s (Erro %lu)\n", mensagem, codigo);
+}
+
+// =============================================================
+// Segmentos mapeados
+// =============================================================
+
+// Função para (re)criar o mapeamento com pelo menos 'tamanho' bytes
+int mapearSegmento(Segmento *s, uint64_t tamanho) {
+    if (s->base) {
+        FlushViewOfFile(s->base, 0);
+        UnmapViewOfFile(s->base);
+        CloseHandle(s->mapeamento);
+        s->base = NULL;
+    }
+
+    // CreateFileMappingA estende o arquivo ate o tamanho pedido
+    s->mapeamento = CreateFileMappingA(s->arquivo, NULL, PAGE_READWRITE,
+                                       (DWORD)(tamanho >> 32), (DWORD)(tamanho & 0xFFFFFFFFu), NULL);
+    if (s->mapeamento == NULL) {
+        mostrarErro("Falha ao criar mapeamento");
+        return 0;
+    }
+
+    s->base = (unsigned char *)MapViewOfFile(s->mapeamento, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (s->base == NULL) {
+        mostrarErro("Falha ao mapear arquivo");
+        CloseHandle(s->mapeamento);
+        return 0;
+    }
+    s->tamanho = tamanho;
+    return 1;
+}
+
+// Função para abrir (ou criar) um arquivo e mapea-lo com tamanho minimo
+int abrirSegmento(Segmento *s, const char *nome, uint64_t tamanhoMinimo, int *criado) {
+    LARGE_INTEGER tamanhoAtual;
+
+    s->base = NULL;
+    s->arquivo = CreateFileA(
+        nome,
+        GENERIC_READ | GENERIC_WRITE,
+        0,
+        NULL,
+        OPEN_ALWAYS,
+        FILE_ATTRIBUTE_NORMAL,
+        NULL
+    );
+
+    if (s->arquivo == INVALID_HANDLE_VALUE) {
+        mostrarErro("Falha ao abrir arquivo");
+        s->arquivo = NULL;
+        return 0;
+    }
+
+    if (!GetFileSizeEx(s->arquivo, &tamanhoAtual)) {
+        mostrarErro("Falha ao obter tamanho do arquivo");
+        CloseHandle(s->arquivo);
+        s->arquivo = NULL;
+        return 0;
+    }
+
+    *criado = (tamanhoAtual.QuadPart == 0);
+    if ((uint64_t)tamanhoAtual.QuadPart > tamanhoMinimo)
+        tamanhoMinimo = (uint64_t)tamanhoAtual.QuadPart;
+
+    if (!mapearSegmento(s, tamanhoMinimo)) {
+        CloseHandle(s->arquivo);
+        s->arquivo = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+// Função para garantir espaco; ponteiros antigos para o segmento deixam de valer
+int crescerSegmento(Segmento *s, uint64_t necessario) {
+    uint64_t novo = s->tamanho;
+    if (necessario <= novo)
+        return 1;
+    while (novo < necessario)
+        novo *= 2;
+    return mapearSegmento(s, novo);
+}
+
+void fecharSegmento(Segmento *s) {
+    if (s->base) {
+        FlushViewOfFile(s->base, 0);
+        UnmapViewOfFile(s->base);
+        CloseHandle(s->mapeamento);
+        s->base = NULL;
+    }
+    if (s->arquivo && s->arquivo != INVALID_HANDLE_VALUE)
+        CloseHandle(s->arquivo);
+    s->arquivo = NULL;
+}
+
+// =============================================================
+// Acesso aos arquivos mapeados
+// =============================================================
+
+CabecalhoDados *cabecalhoDados(const LogIndexado *log) {
+    return (CabecalhoDados *)log->dados.base;
+}
+
+RegistroViagem *registros(const LogIndexado *log) {
+    return (RegistroViagem *)(log->dados.base + sizeof(CabecalhoDados));
+}
+
+IndiceHash *indiceHash(const LogIndexado *log) {
+    return (IndiceHash *)log->hash.base;
+}
+
+CabecalhoKm *cabecalhoKm(const LogIndexado *log) {
+    return (CabecalhoKm *)log->km.base;
+}
+
+// Cauda nao ordenada logo apos o cabecalho; nivel k comeca em RUN_BASE * (2^k - 1)
+EntradaKm *caudaKm(const LogIndexado *log) {
+    return (EntradaKm *)(log->km.base + sizeof(CabecalhoKm));
+}
+
+EntradaKm *nivelKm(const LogIndexado *log, int nivel) {
+    return caudaKm(log) + RUN_BASE + (uint64_t)RUN_BASE * ((1ull << nivel) - 1);
+}
+
+uint64_t tamanhoArquivoKm(int niveis) {
+    return sizeof(CabecalhoKm) + (RUN_BASE + (uint64_t)RUN_BASE * ((1ull << niveis) - 1)) * sizeof(EntradaKm);
+}
+
+// Hash FNV-1a do destino
+uint32_t hashDestino(const char *destino) {
+    uint32_t h = 2166136261u;
+    while (*destino) {
+        h ^= (unsigned char)*destino++;
+        h *= 16777619u;
+    }
+    return h & (NUM_BUCKETS - 1);
+}
+
+// =============================================================
+// Indice esparso por quilometragem
+// =============================================================
+
+// Função para reconstruir as chaves esparsas de um nivel ja ordenado
+int reconstruirEsparsas(LogIndexado *log, int nivel) {
+    ChavesEsparsas *e = &log->esparsas[nivel];
+    EntradaKm *entradas = nivelKm(log, nivel);
+    uint32_t qtd = (uint32_t)(((uint64_t)RUN_BASE << nivel) / PASSO_ESPARSO);
+
+    free(e->chaves);
+    e->chaves = (int32_t *)malloc(qtd * sizeof(int32_t));
+    if (!e->chaves) {
+        e->qtd = 0;
+        printf("Falha ao alocar chaves esparsas\n");
+        return 0;
+    }
+    for (uint32_t i = 0; i < qtd; i++)
+        e->chaves[i] = entradas[(uint64_t)i * PASSO_ESPARSO].quilometragem;
+    e->qtd = qtd;
+    return 1;
+}
+
+int compararEntradaKm(const void *a, const void *b) {
+    const EntradaKm *x = (const EntradaKm *)a;
+    const EntradaKm *y = (const EntradaKm *)b;
+    if (x->quilometragem != y->quilometragem)
+        return x->quilometragem < y->quilometragem ? -1 : 1;
+    return x->registro < y->registro ? -1 : (x->registro > y->registro);
+}
+
+// Função para ordenar a cauda e propaga-la pelos niveis (como um contador binario)
+int compactarCaudaKm(LogIndexado *log) {
+    CabecalhoKm *cab = cabecalhoKm(log);
+    uint32_t mascara = cab->niveisOcupados;
+    int destino = 0;
+
+    // O carry termina no primeiro nivel vazio; garante espaco para ele antes de ler
+    while (mascara & (1u << destino))
+        destino++;
+    if (destino >= MAX_NIVEIS) {
+        printf("Indice de quilometragem cheio\n");
+        return 0;
+    }
+    if (!crescerSegmento(&log->km, tamanhoArquivoKm(destino + 1)))
+        return 0;
+    cab = cabecalhoKm(log);
+
+    uint64_t qtdCarry = RUN_BASE;
+    EntradaKm *carry = (EntradaKm *)malloc((size_t)((uint64_t)RUN_BASE << destino) * sizeof(EntradaKm));
+    EntradaKm *aux = (EntradaKm *)malloc((size_t)((uint64_t)RUN_BASE << destino) * sizeof(EntradaKm));
+    if (!carry || !aux) {
+        printf("Falha ao alocar memoria para compactacao\n");
+        free(carry);
+        free(aux);
+        return 0;
+    }
+
+    memcpy(carry, caudaKm(log), RUN_BASE * sizeof(EntradaKm));
+    qsort(carry, RUN_BASE, sizeof(EntradaKm), compararEntradaKm);
+
+    // Intercala o carry com cada nivel ocupado abaixo do destino
+    for (int nivel = 0; nivel < destino; nivel++) {
+        EntradaKm *a = nivelKm(log, nivel);
+        uint64_t i = 0, j = 0, k = 0;
+        while (i < qtdCarry && j < qtdCarry) {
+            if (compararEntradaKm(&carry[i], &a[j]) <= 0) aux[k++] = carry[i++];
+            else aux[k++] = a[j++];
+        }
+        while (i < qtdCarry) aux[k++] = carry[i++];
+        while (j < qtdCarry) aux[k++] = a[j++];
+
+        EntradaKm *troca = carry;
+        carry = aux;
+        aux = troca;
+        qtdCarry = k;
+
+        free(log->esparsas[nivel].chaves);
+        log->esparsas[nivel].chaves = NULL;
+        log->esparsas[nivel].qtd = 0;
+    }
+
+    memcpy(nivelKm(log, destino), carry, qtdCarry * sizeof(EntradaKm));
+    free(carry);
+    free(aux);
+
+    cab->niveisOcupados = (mascara & ~((1u << destino) - 1)) | (1u << destino);
+    cab->qtdCauda = 0;
+    return reconstruirEsparsas(log, destino);
+}
+
+// Função para inserir um registro na cauda do indice de km (compacta quando enche)
+int indexarKm(LogIndexado *log, int32_t quilometragem, uint32_t indice) {
+    CabecalhoKm *cab = cabecalhoKm(log);
+    caudaKm(log)[cab->qtdCauda].quilometragem = quilometragem;
+    caudaKm(log)[cab->qtdCauda].registro = indice;
+    cab->qtdCauda++;
+    if (cab->qtdCauda == RUN_BASE)
+        return compactarCaudaKm(log);
+    return 1;
+}
+
+// =============================================================
+// Abertura, insercao e fechamento
+// =============================================================
+
+void fecharLog(LogIndexado *log) {
+    for (int nivel = 0; nivel < MAX_NIVEIS; nivel++) {
+        free(log->esparsas[nivel].chaves);
+        log->esparsas[nivel].chaves = NULL;
+    }
+    fecharSegmento(&log->km);
+    fecharSegmento(&log->hash);
+    fecharSegmento(&log->dados);
+}
+
+// Fecha os segmentos que chegaram a ser abertos antes da falha
+int falhaAbertura(LogIndexado *log) {
+    fecharLog(log);
+    return 0;
+}
+
+// Função para refazer um indice recriado vazio a partir dos registros ja gravados
+int reconstruirIndices(LogIndexado *log, int hash, int km) {
+    uint64_t total = cabecalhoDados(log)->total;
+    printf("Reconstruindo indice%s%s a partir de %llu registros...\n", hash ? " hash" : "",
+           km ? (hash ? " e de quilometragem" : " de quilometragem") : "", (unsigned long long)total);
+
+    for (uint64_t i = 0; i < total; i++) {
+        RegistroViagem *r = &registros(log)[i];
+        if (hash) {
+            // Mesma ordem de insercao: a cadeia de cada bucket volta a ser a original
+            uint32_t bucket = hashDestino(r->destino);
+            r->proximo = indiceHash(log)->cabecas[bucket];
+            indiceHash(log)->cabecas[bucket] = (uint32_t)i;
+        }
+        if (km && !indexarKm(log, r->quilometragem, (uint32_t)i))
+            return 0;
+    }
+    return 1;
+}
+
+int abrirLog(LogIndexado *log) {
+    int criado, hashCriado, kmCriado;
+
+    memset(log, 0, sizeof(*log));
+
+    if (!abrirSegmento(&log->dados, DATA_FILE,
+                       sizeof(CabecalhoDados) + (uint64_t)CAPACIDADE_INICIAL * sizeof(RegistroViagem), &criado))
+        return falhaAbertura(log);
+    if (criado) {
+        cabecalhoDados(log)->magic = MAGIC_DADOS;
+        cabecalhoDados(log)->tamanhoRegistro = sizeof(RegistroViagem);
+        cabecalhoDados(log)->total = 0;
+    } else if (cabecalhoDados(log)->magic != MAGIC_DADOS ||
+               cabecalhoDados(log)->tamanhoRegistro != sizeof(RegistroViagem)) {
+        printf("Arquivo de dados invalido: %s\n", DATA_FILE);
+        return falhaAbertura(log);
+    }
+
+    if (!abrirSegmento(&log->hash, HASH_FILE, sizeof(IndiceHash), &hashCriado))
+        return falhaAbertura(log);
+    if (hashCriado) {
+        indiceHash(log)->magic = MAGIC_HASH;
+        indiceHash(log)->numBuckets = NUM_BUCKETS;
+        memset(indiceHash(log)->cabecas, 0xFF, sizeof(indiceHash(log)->cabecas));
+    } else if (indiceHash(log)->magic != MAGIC_HASH || indiceHash(log)->numBuckets != NUM_BUCKETS) {
+        printf("Indice hash invalido: %s\n", HASH_FILE);
+        return falhaAbertura(log);
+    }
+
+    if (!abrirSegmento(&log->km, KM_FILE, tamanhoArquivoKm(0), &kmCriado))
+        return falhaAbertura(log);
+    if (kmCriado) {
+        cabecalhoKm(log)->magic = MAGIC_KM;
+    } else if (cabecalhoKm(log)->magic != MAGIC_KM) {
+        printf("Indice de quilometragem invalido: %s\n", KM_FILE);
+        return falhaAbertura(log);
+    }
+
+    for (int nivel = 0; nivel < MAX_NIVEIS; nivel++)
+        if (cabecalhoKm(log)->niveisOcupados & (1u << nivel))
+            if (!reconstruirEsparsas(log, nivel))
+                return falhaAbertura(log);
+
+    // Indice apagado com dados existentes: sem reconstruir, as consultas perderiam os registros antigos
+    if (cabecalhoDados(log)->total > 0 && (hashCriado || kmCriado))
+        if (!reconstruirIndices(log, hashCriado, kmCriado))
+            return falhaAbertura(log);
+
+    return 1;
+}
+
+// Função para anexar um registro e atualizar os dois indices
+int anexarViagem(LogIndexado *log, int32_t quilometragem, float combustivel, const char *destino) {
+    uint64_t total = cabecalhoDados(log)->total;
+
+    if (total >= NENHUM) {
+        printf("Limite de registros atingido\n");
+        return 0;
+    }
+    // O hash e a comparacao usam o nome inteiro: um nome truncado nunca seria encontrado
+    if (strlen(destino) >= DESTINO_MAX) {
+        printf("Destino com mais de %d caracteres: %s\n", DESTINO_MAX - 1, destino);
+        return 0;
+    }
+    if (!crescerSegmento(&log->dados, sizeof(CabecalhoDados) + (total + 1) * sizeof(RegistroViagem)))
+        return 0;
+
+    uint32_t indice = (uint32_t)total;
+    uint32_t bucket = hashDestino(destino);
+    RegistroViagem *r = &registros(log)[indice];
+
+    // O registro guarda a antiga cabeca do bucket: a cadeia cresce sem reescrever nada
+    r->quilometragem = quilometragem;
+    r->combustivel = combustivel;
+    r->proximo = indiceHash(log)->cabecas[bucket];
+    memset(r->destino, 0, DESTINO_MAX);
+    memcpy(r->destino, destino, strlen(destino));
+
+    // Publica o registro somente depois de preenchido
+    cabecalhoDados(log)->total = total + 1;
+    indiceHash(log)->cabecas[bucket] = indice;
+
+    return indexarKm(log, quilometragem, indice);
+}
+
+// =============================================================
+// Consultas (zero-copy)
+// =============================================================
+
+// Função para visitar todos os registros de um destino; retorna quantos foram encontrados
+uint64_t consultarDestino(const LogIndexado *log, const char *destino, VisitanteViagem visitar, void *contexto) {
+    const RegistroViagem *base = registros(log);
+    uint32_t indice = indiceHash(log)->cabecas[hashDestino(destino)];
+    uint64_t encontrados = 0;
+
+    // A cadeia vai do registro mais recente para o mais antigo
+    while (indice != NENHUM) {
+        const RegistroViagem *r = &base[indice];
+        if (strncmp(r->destino, destino, DESTINO_MAX) == 0) {
+            visitar(r, indice, contexto);
+            encontrados++;
+        }
+        indice = r->proximo;
+    }
+    return encontrados;
+}
+
+// Função para visitar registros com quilometragem em [minimo, maximo]
+uint64_t consultarQuilometragem(const LogIndexado *log, int32_t minimo, int32_t maximo,
+                                VisitanteViagem visitar, void *contexto) {
+    const RegistroViagem *base = registros(log);
+    const CabecalhoKm *cab = cabecalhoKm(log);
+    uint64_t encontrados = 0;
+
+    for (int nivel = 0; nivel < MAX_NIVEIS; nivel++) {
+        if (!(cab->niveisOcupados & (1u << nivel)))
+            continue;
+
+        const ChavesEsparsas *e = &log->esparsas[nivel];
+        const EntradaKm *entradas = nivelKm(log, nivel);
+        uint64_t qtd = (uint64_t)RUN_BASE << nivel;
+
+        // Busca binaria nas chaves esparsas: primeiro bloco cuja chave inicial >= minimo
+        uint32_t lo = 0, hi = e->qtd;
+        while (lo < hi) {
+            uint32_t meio = lo + (hi - lo) / 2;
+            if (e->chaves[meio] < minimo) lo = meio + 1;
+            else hi = meio;
+        }
+        uint64_t i = (lo > 0 ? (uint64_t)(lo - 1) : 0) * PASSO_ESPARSO;
+
+        while (i < qtd && entradas[i].quilometragem < minimo)
+            i++;
+        for (; i < qtd && entradas[i].quilometragem <= maximo; i++) {
+            visitar(&base[entradas[i].registro], entradas[i].registro, contexto);
+            encontrados++;
+        }
+    }
+
+    // Cauda ainda nao ordenada (no maximo RUN_BASE entradas)
+    const EntradaKm *cauda = caudaKm(log);
+    for (uint32_t i = 0; i < cab->qtdCauda; i++) {
+        if (cauda[i].quilometragem >= minimo && cauda[i].quilometragem <= maximo) {
+            visitar(&base[cauda[i].registro], cauda[i].registro, contexto);
+            encontrados++;
+        }
+    }
+    return encontrados;
+}
+
+// =============================================================
+// Demonstracao
+// =============================================================
+
+typedef struct {
+    uint64_t exibidos;
+    double combustivelTotal;
+} ResumoConsulta;
+
+void acumularViagem(const RegistroViagem *r, uint32_t indice, void *contexto) {
+    ResumoConsulta *resumo = (ResumoConsulta *)contexto;
+    if (resumo->exibidos < 3) {
+        printf("  #%-10lu Quilometragem: %-8d Combustivel: %-8.2f Destino: %s\n",
+               (unsigned long)indice, r->quilometragem, r->combustivel, r->destino);
+    }
+    resumo->exibidos++;
+    resumo->combustivelTotal += r->combustivel;
+}
+
+double segundosDesde(LARGE_INTEGER inicio) {
+    LARGE_INTEGER fim, frequencia;
+    QueryPerformanceCounter(&fim);
+    QueryPerformanceFrequency(&frequencia);
+    return (double)(fim.QuadPart - inicio.QuadPart) / (double)frequencia.QuadPart;
+}
+
+int main(int argc, char **argv) {
+    const char *destinos[] = {"Sao Paulo", "Rio de Janeiro", "Curitiba", "Belo Horizonte",
+                              "Salvador", "Recife", "Porto Alegre", "Manaus"};
+    const int numDestinos = sizeof(destinos) / sizeof(destinos[0]);
+    unsigned long novos = argc > 1 ? strtoul(argv[1], NULL, 10) : 1000000;
+    LogIndexado log;
+    LARGE_INTEGER inicio;
+    ResumoConsulta resumo;
+
+    if (!abrirLog(&log)) {
+        return 1;
+    }
+    printf("Log aberto: %llu registros existentes.\n", (unsigned long long)cabecalhoDados(&log)->total);
+
+    // Anexar registros de exemplo (indices atualizados a cada insercao)
+    srand(42);
+    QueryPerformanceCounter(&inicio);
+    for (unsigned long i = 0; i < novos; i++) {
+        int32_t km = rand() % 5000;
+        float combustivel = km / 12.0f;
+        if (!anexarViagem(&log, km, combustivel, destinos[rand() % numDestinos])) {
+            fecharLog(&log);
+            return 1;
+        }
+    }
+    printf("%lu registros anexados em %.3f s.\n", novos, segundosDesde(inicio));
+
+    // Consulta por destino
+    memset(&resumo, 0, sizeof(resumo));
+    QueryPerformanceCounter(&inicio);
+    uint64_t n = consultarDestino(&log, "Curitiba", acumularViagem, &resumo);
+    printf("Destino = Curitiba: %llu registros, %.2f L no total (%.3f s)\n\n",
+           (unsigned long long)n, resumo.combustivelTotal, segundosDesde(inicio));
+
+    // Consulta por faixa de quilometragem
+    memset(&resumo, 0, sizeof(resumo));
+    QueryPerformanceCounter(&inicio);
+    n = consultarQuilometragem(&log, 250, 260, acumularViagem, &resumo);
+    printf("Quilometragem em [250, 260]: %llu registros, %.2f L no total (%.3f s)\n",
+           (unsigned long long)n, resumo.combustivelTotal, segundosDesde(inicio));
+
+    // Fechar
+    fecharLog(&log);
+    printf("\nArquivos fechados com sucesso.\n");
+
+    return 0;
+}
@@ -0,0 +1,518 @@
+/**
+ * ============================================================
+ *  Analisador do Mapa de Memória de um Processo em Execução
+ *  Autor: Gabriel Rozendo
+ *  Capítulo: 15 – Uso de Memória (TEXT, DATA, BSS, HEAP, STACK)
+ * ============================================================
+ *  Objetivo:
+ *  - Ir além de memory_structure.cpp, que rotula cinco variáveis
+ *    fixas: aqui qualquer PID é analisado a partir do /proc.
+ *  - Ler /proc/<pid>/smaps (que repete as linhas de maps com as
+ *    estatísticas de cada região) e /proc/<pid>/pagemap em fluxo,
+ *    com um buffer fixo, sem carregar os arquivos inteiros.
+ *  - Classificar cada região:
+ *      TEXT   → código de executável/biblioteca (r-x)
+ *      RODATA → partes somente leitura de executável/biblioteca
+ *      DATA   → dados inicializados de executável/biblioteca (rw)
+ *      BSS    → região anônima logo após o DATA de um binário
+ *      HEAP   → [heap] (brk)
+ *      STACK  → [stack] da thread principal
+ *      ANON   → demais regiões anônimas (malloc grande, pilhas de threads)
+ *      MMAP   → arquivos mapeados, memória compartilhada
+ *      KERNEL → [vdso], [vvar], [vsyscall]
+ *    e contabilizar THP (huge pages transparentes) por região.
+ *  - Reportar RSS, PSS, swap, cobertura de huge pages e densidade
+ *    de páginas residentes por região e por classe.
+ * ============================================================
+ *  Desempenho:
+ *  - O pagemap só é lido para regiões parcialmente residentes; as
+ *    vazias (RSS = 0) e as totalmente residentes são resolvidas
+ *    pelos números do smaps. Assim, um espaço de 100 GB quase todo
+ *    reservado e não tocado é analisado em milissegundos.
+ * ============================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// =====================
+// CONSTANTES
+// =====================
+
+#define TAMANHO_BUFFER (256 * 1024)      // buffer de leitura em fluxo
+#define ENTRADAS_PAGEMAP 32768           // 256 KB de pagemap por pread
+#define PAGINAS_POR_HUGE 512             // 2 MB / 4 KB
+#define REGIOES_EXIBIDAS 25              // top N por RSS (use --todas para todas)
+
+// Bits de cada entrada de 64 bits do pagemap (Documentation/admin-guide/mm/pagemap.rst)
+#define PM_PRESENTE   (1ull << 63)
+
+enum Classe { TEXT, RODATA, DATA, BSS, HEAP, STACK, ANON, MMAP, KERNEL, NUM_CLASSES };
+
+static const char *NOMES_CLASSE[NUM_CLASSES] = {
+    "TEXT", "RODATA", "DATA", "BSS", "HEAP", "STACK", "ANON", "MMAP", "KERNEL"
+};
+
+// =====================
+// ESTRUTURAS
+// =====================
+
+typedef struct {
+    uint64_t inicio, fim;
+    char perms[5];
+    uint64_t inode;
+    std::string caminho;
+    Classe classe;
+
+    // Valores do smaps, em kB
+    uint64_t rss, pss, swap, anon_huge, file_pmd, shmem_pmd;
+
+    // Valores do pagemap, em páginas
+    uint64_t presentes, janelas_2m;
+} Regiao;
+
+typedef struct {
+    uint64_t regioes, vsz, rss, pss, swap, huge, janelas_2m, presentes;
+} Totais;
+
+/**
+ * @brief Leitor de linhas em fluxo: um único buffer fixo, sem alocar por linha.
+ */
+typedef struct {
+    int fd;
+    char *buf;
+    size_t ini, fim;
+    bool eof;
+} LeitorLinhas;
+
+bool abrir_leitor(LeitorLinhas *l, const char *caminho) {
+    l->fd = open(caminho, O_RDONLY | O_CLOEXEC);
+    if (l->fd < 0)
+        return false;
+    l->buf = (char *) malloc(TAMANHO_BUFFER);
+    if (!l->buf) {
+        close(l->fd);
+        return false;
+    }
+    l->ini = l->fim = 0;
+    l->eof = false;
+    return true;
+}
+
+void fechar_leitor(LeitorLinhas *l) {
+    free(l->buf);
+    close(l->fd);
+}
+
+/**
+ * @brief Devolve a próxima linha (sem '\n') terminada em '\0' dentro do buffer.
+ * @return ponteiro para a linha, ou NULL no fim do arquivo
+ */
+char *proxima_linha(LeitorLinhas *l) {
+    for (;;) {
+        char *nl = (char *) memchr(l->buf + l->ini, '\n', l->fim - l->ini);
+        if (nl) {
+            char *linha = l->buf + l->ini;
+            *nl = '\0';
+            l->ini = (size_t) (nl - l->buf) + 1;
+            return linha;
+        }
+        if (l->eof) {
+            if (l->ini == l->fim)
+                return NULL;
+            // Última linha sem '\n'
+            if (l->fim == TAMANHO_BUFFER) l->fim--;
+            l->buf[l->fim] = '\0';
+            char *linha = l->buf + l->ini;
+            l->ini = l->fim;
+            return linha;
+        }
+
+        // Move o resto para o início e lê mais
+        memmove(l->buf, l->buf + l->ini, l->fim - l->ini);
+        l->fim -= l->ini;
+        l->ini = 0;
+        if (l->fim == TAMANHO_BUFFER)
+            l->fim = 0;   // linha maior que o buffer: descarta
+        ssize_t n = read(l->fd, l->buf + l->fim, TAMANHO_BUFFER - l->fim);
+        if (n <= 0)
+            l->eof = true;
+        else
+            l->fim += (size_t) n;
+    }
+}
+
+// =====================
+// PARSE DE maps / smaps
+// =====================
+
+static uint64_t ler_hex(const char **p) {
+    uint64_t v = 0;
+    for (;; (*p)++) {
+        char c = **p;
+        if (c >= '0' && c <= '9') v = (v << 4) | (uint64_t) (c - '0');
+        else if (c >= 'a' && c <= 'f') v = (v << 4) | (uint64_t) (c - 'a' + 10);
+        else return v;
+    }
+}
+
+static uint64_t ler_dec(const char **p) {
+    uint64_t v = 0;
+    while (**p == ' ') (*p)++;
+    while (**p >= '0' && **p <= '9') v = v * 10 + (uint64_t) (*(*p)++ - '0');
+    return v;
+}
+
+/**
+ * @brief Interpreta "inicio-fim perms offset dev inode caminho" (linha de maps).
+ */
+bool ler_cabecalho(const char *p, Regiao *r) {
+    r->inicio = ler_hex(&p);
+    if (*p++ != '-') return false;
+    r->fim = ler_hex(&p);
+    if (*p++ != ' ') return false;
+    memcpy(r->perms, p, 4);
+    r->perms[4] = '\0';
+    p += 5;
+    ler_hex(&p);                       // offset
+    while (*p == ' ') p++;
+    while (*p && *p != ' ') p++;       // dispositivo (maj:min)
+    r->inode = ler_dec(&p);
+    while (*p == ' ') p++;
+    r->caminho.assign(p);
+    return true;
+}
+
+/**
+ * @brief Interpreta uma linha "Chave:   123 kB" do smaps.
+ */
+void ler_campo_smaps(const char *p, Regiao *r) {
+    const char *dois_pontos = strchr(p, ':');
+    if (!dois_pontos) return;
+    size_t n = (size_t) (dois_pontos - p);
+    const char *v = dois_pontos + 1;
+
+#define CAMPO(nome, destino) \
+    if (n == sizeof(nome) - 1 && memcmp(p, nome, n) == 0) { r->destino = ler_dec(&v); return; }
+    CAMPO("Rss", rss)
+    CAMPO("Pss", pss)
+    CAMPO("Swap", swap)
+    CAMPO("AnonHugePages", anon_huge)
+    CAMPO("FilePmdMapped", file_pmd)
+    CAMPO("ShmemPmdMapped", shmem_pmd)
+#undef CAMPO
+}
+
+/**
+ * @brief Lê smaps (ou maps, se smaps não puder ser aberto) em fluxo.
+ */
+bool ler_regioes(int pid, std::vector<Regiao> &regioes, bool *com_smaps) {
+    char caminho[64];
+    LeitorLinhas l;
+
+    snprintf(caminho, sizeof(caminho), "/proc/%d/smaps", pid);
+    *com_smaps = abrir_leitor(&l, caminho);
+    if (!*com_smaps) {
+        snprintf(caminho, sizeof(caminho), "/proc/%d/maps", pid);
+        if (!abrir_leitor(&l, caminho))
+            return false;
+    }
+
+    char *linha;
+    while ((linha = proxima_linha(&l)) != NULL) {
+        // Linhas de região começam com endereço em hexadecimal minúsculo;
+        // campos do smaps começam com letra maiúscula ("Rss:", "VmFlags:")
+        char c = linha[0];
+        if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f')) {
+            Regiao r = {};
+            if (ler_cabecalho(linha, &r))
+                regioes.push_back(std::move(r));
+        } else if (!regioes.empty()) {
+            ler_campo_smaps(linha, &regioes.back());
+        }
+    }
+    fechar_leitor(&l);
+    return true;
+}
+
+// =====================
+// CLASSIFICAÇÃO
+// =====================
+
+static bool eh_imagem(const std::string &caminho, const std::string &exe) {
+    return caminho == exe || caminho.find(".so") != std::string::npos;
+}
+
+void classificar(std::vector<Regiao> &regioes, const std::string &exe) {
+    for (size_t i = 0; i < regioes.size(); i++) {
+        Regiao &r = regioes[i];
+        const std::string &c = r.caminho;
+
+        if (c == "[heap]") r.classe = HEAP;
+        else if (c == "[stack]") r.classe = STACK;
+        else if (c == "[vdso]" || c == "[vvar]" || c == "[vsyscall]" || c == "[vvar_vclock]") r.classe = KERNEL;
+        else if (!c.empty() && c[0] == '/' && eh_imagem(c, exe)) {
+            if (r.perms[2] == 'x') r.classe = TEXT;
+            else if (r.perms[1] == 'w') r.classe = DATA;
+            else r.classe = RODATA;
+        } else if (c.empty() || c[0] == '[') {
+            // Anônima colada no fim do DATA de um binário → BSS
+            bool bss = i > 0 && r.perms[1] == 'w' && regioes[i - 1].fim == r.inicio &&
+                       regioes[i - 1].classe == DATA;
+            r.classe = bss ? BSS : ANON;
+        } else {
+            r.classe = MMAP;
+        }
+    }
+}
+
+// =====================
+// PAGEMAP
+// =====================
+
+/**
+ * @brief Conta páginas presentes e janelas de 2 MB com ao menos uma página presente.
+ *
+ * Só é chamada para regiões parcialmente residentes; lê o pagemap em
+ * blocos de ENTRADAS_PAGEMAP entradas com pread().
+ */
+bool ler_pagemap(int fd, Regiao *r, uint64_t *entradas, long pagina) {
+    uint64_t vpn = r->inicio / (uint64_t) pagina;
+    uint64_t vpn_fim = r->fim / (uint64_t) pagina;
+    uint64_t ultima_janela = UINT64_MAX;
+
+    while (vpn < vpn_fim) {
+        uint64_t n = std::min<uint64_t>(vpn_fim - vpn, ENTRADAS_PAGEMAP);
+        ssize_t lidos = pread(fd, entradas, n * sizeof(uint64_t), (off_t) (vpn * sizeof(uint64_t)));
+        if (lidos <= 0)
+            return false;
+        n = (uint64_t) lidos / sizeof(uint64_t);
+
+        for (uint64_t i = 0; i < n; i++) {
+            uint64_t e = entradas[i];
+            if (e & PM_PRESENTE) {
+                r->presentes++;
+                uint64_t janela = (vpn + i) / PAGINAS_POR_HUGE;
+                if (janela != ultima_janela) {
+                    r->janelas_2m++;
+                    ultima_janela = janela;
+                }
+            }
+        }
+        vpn += n;
+    }
+    return true;
+}
+
+void completar_residencia(int pid, std::vector<Regiao> &regioes, bool usar_pagemap, bool *pagemap_ok) {
+    long pagina = sysconf(_SC_PAGESIZE);
+    char caminho[64];
+    int fd = -1;
+    uint64_t *entradas = NULL;
+
+    if (usar_pagemap) {
+        snprintf(caminho, sizeof(caminho), "/proc/%d/pagemap", pid);
+        fd = open(caminho, O_RDONLY | O_CLOEXEC);
+        entradas = (uint64_t *) malloc(ENTRADAS_PAGEMAP * sizeof(uint64_t));
+    }
+    *pagemap_ok = fd >= 0 && entradas;
+
+    for (Regiao &r : regioes) {
+        uint64_t paginas = (r.fim - r.inicio) / (uint64_t) pagina;
+        uint64_t rss_paginas = r.rss * 1024 / (uint64_t) pagina;
+
+        if (*pagemap_ok && rss_paginas > 0 && rss_paginas < paginas && ler_pagemap(fd, &r, entradas, pagina))
+            continue;
+
+        // Vazia ou totalmente residente: o smaps já responde
+        r.presentes = rss_paginas;
+        if (rss_paginas == 0) {
+            r.janelas_2m = 0;
+        } else {
+            uint64_t primeira = r.inicio / (uint64_t) pagina / PAGINAS_POR_HUGE;
+            uint64_t ultima = (r.fim / (uint64_t) pagina - 1) / PAGINAS_POR_HUGE;
+            r.janelas_2m = ultima - primeira + 1;
+        }
+    }
+
+    free(entradas);
+    if (fd >= 0) close(fd);
+}
+
+// =====================
+// RELATÓRIO
+// =====================
+
+static double pct(uint64_t parte, uint64_t todo) {
+    return todo ? 100.0 * (double) parte / (double) todo : 0.0;
+}
+
+static uint64_t huge_kb(const Regiao &r) {
+    return r.anon_huge + r.file_pmd + r.shmem_pmd;
+}
+
+void print_regiao(const Regiao &r, long pagina) {
+    uint64_t vsz = (r.fim - r.inicio) / 1024;
+    uint64_t pag_janelas = r.janelas_2m * PAGINAS_POR_HUGE;
+    const char *nome = r.caminho.empty() ? "[anon]" : r.caminho.c_str();
+    size_t len = strlen(nome);
+
+    printf("%012llx-%012llx %s %-6s%s %10llu %10llu %10llu %6.1f%% %6.1f%% %6.1f%%  %s\n",
+           (unsigned long long) r.inicio, (unsigned long long) r.fim, r.perms,
+           NOMES_CLASSE[r.classe], huge_kb(r) ? "+THP" : "    ",
+           (unsigned long long) vsz, (unsigned long long) r.rss, (unsigned long long) r.pss,
+           pct(huge_kb(r), r.rss), pct(r.presentes * (uint64_t) pagina / 1024, vsz),
+           pct(r.presentes, pag_janelas),
+           len > 40 ? nome + len - 40 : nome);
+}
+
+void print_resumo(const Totais *t, const char *nome, long pagina) {
+    printf("%-14s %7llu %12llu %12llu %12llu %10llu %6.1f%% %6.1f%% %6.1f%%\n", nome,
+           (unsigned long long) t->regioes, (unsigned long long) t->vsz, (unsigned long long) t->rss,
+           (unsigned long long) t->pss, (unsigned long long) t->swap,
+           pct(t->huge, t->rss), pct(t->presentes * (uint64_t) pagina / 1024, t->vsz),
+           pct(t->presentes, t->janelas_2m * PAGINAS_POR_HUGE));
+}
+
+static void acumular(Totais *t, const Regiao &r) {
+    t->regioes++;
+    t->vsz += (r.fim - r.inicio) / 1024;
+    t->rss += r.rss;
+    t->pss += r.pss;
+    t->swap += r.swap;
+    t->huge += huge_kb(r);
+    t->janelas_2m += r.janelas_2m;
+    t->presentes += r.presentes;
+}
+
+// Variáveis do demonstrador original, usadas quando nenhum PID é informado
+int global_inicializada = 42;
+int global_nao_inicializada;
+
+void localizar(const std::vector<Regiao> &regioes, const char *nome, const void *endereco) {
+    uint64_t a = (uint64_t) (uintptr_t) endereco;
+    for (const Regiao &r : regioes) {
+        if (a >= r.inicio && a < r.fim) {
+            printf("%-32s -> Endereço: %p   | Segmento: %s\n", nome, endereco, NOMES_CLASSE[r.classe]);
+            return;
+        }
+    }
+    printf("%-32s -> Endereço: %p   | Segmento: ?\n", nome, endereco);
+}
+
+static double agora_s(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double) t.tv_sec + (double) t.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    int pid = getpid();
+    bool proprio = true, todas = false, usar_pagemap = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--todas") == 0) todas = true;
+        else if (strcmp(argv[i], "--sem-pagemap") == 0) usar_pagemap = false;
+        else if (atoi(argv[i]) > 0) { pid = atoi(argv[i]); proprio = false; }
+        else {
+            fprintf(stderr, "Uso: %s [pid] [--todas] [--sem-pagemap]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Quando analisa a si mesmo, garante que há algo no HEAP, como no demonstrador original
+    int variavel_local = 99;
+    int *ponteiro_heap = (int *) malloc(sizeof(int));
+    if (!ponteiro_heap) {
+        fprintf(stderr, "Erro: falha ao alocar memória dinâmica.\n");
+        return EXIT_FAILURE;
+    }
+    *ponteiro_heap = 1234;
+
+    double t0 = agora_s();
+
+    char caminho[64], exe_buf[4096];
+    snprintf(caminho, sizeof(caminho), "/proc/%d/exe", pid);
+    ssize_t n = readlink(caminho, exe_buf, sizeof(exe_buf) - 1);
+    std::string exe = n > 0 ? std::string(exe_buf, (size_t) n) : std::string();
+
+    std::vector<Regiao> regioes;
+    bool com_smaps, pagemap_ok;
+    if (!ler_regioes(pid, regioes, &com_smaps)) {
+        fprintf(stderr, "Erro: não foi possível ler /proc/%d/maps: %s\n", pid, strerror(errno));
+        free(ponteiro_heap);
+        return EXIT_FAILURE;
+    }
+    classificar(regioes, exe);
+    completar_residencia(pid, regioes, usar_pagemap && com_smaps, &pagemap_ok);
+
+    double t1 = agora_s();
+    long pagina = sysconf(_SC_PAGESIZE);
+
+    printf("===========================================================\n");
+    printf("   MAPA DE MEMÓRIA DO PROCESSO %d\n", pid);
+    printf("===========================================================\n");
+    printf("Executável : %s\n", exe.empty() ? "(desconhecido)" : exe.c_str());
+    printf("Fontes     : %s%s\n", com_smaps ? "smaps" : "maps (sem permissão para smaps)",
+           pagemap_ok ? " + pagemap" : "");
+    printf("Regiões    : %zu   |   análise em %.3f ms\n\n", regioes.size(), (t1 - t0) * 1000.0);
+
+    // Regiões ordenadas por RSS (as maiores primeiro)
+    std::vector<const Regiao *> ordem;
+    for (const Regiao &r : regioes) ordem.push_back(&r);
+    std::stable_sort(ordem.begin(), ordem.end(),
+                     [](const Regiao *a, const Regiao *b) { return a->rss > b->rss; });
+    size_t exibir = todas ? ordem.size() : std::min<size_t>(ordem.size(), REGIOES_EXIBIDAS);
+
+    printf("🔹 Regiões por RSS (%zu de %zu; kB):\n\n", exibir, ordem.size());
+    printf("%-25s %-4s %-10s %10s %10s %10s %7s %7s %7s  %s\n", "Intervalo", "Perm", "Classe",
+           "VSZ", "RSS", "PSS", "Huge", "Resid.", "Dens2M", "Mapeamento");
+    for (size_t i = 0; i < exibir; i++)
+        print_regiao(*ordem[i], pagina);
+
+    Totais por_classe[NUM_CLASSES] = {}, thp = {}, total = {};
+    for (const Regiao &r : regioes) {
+        acumular(&por_classe[r.classe], r);
+        acumular(&total, r);
+        if (huge_kb(r)) acumular(&thp, r);
+    }
+
+    printf("\n🔹 Resumo por classe (kB):\n\n");
+    printf("%-14s %7s %12s %12s %12s %10s %7s %7s %7s\n", "Classe", "Regiões", "VSZ", "RSS", "PSS",
+           "Swap", "Huge", "Resid.", "Dens2M");
+    for (int c = 0; c < NUM_CLASSES; c++)
+        if (por_classe[c].regioes) print_resumo(&por_classe[c], NOMES_CLASSE[c], pagina);
+    print_resumo(&thp, "THP (regiões)", pagina);
+    print_resumo(&total, "TOTAL", pagina);
+
+    if (proprio) {
+        printf("\n🔹 Variáveis do demonstrador original:\n\n");
+        localizar(regioes, "Função main()", (void *) main);
+        localizar(regioes, "Variável global_inicializada", &global_inicializada);
+        localizar(regioes, "Variável global_nao_inicializada", &global_nao_inicializada);
+        localizar(regioes, "Ponteiro alocado (malloc)", ponteiro_heap);
+        localizar(regioes, "Variável local (main)", &variavel_local);
+    }
+
+    printf("\n===========================================================\n");
+    printf("   LEGENDA:\n");
+    printf("===========================================================\n");
+    printf("• Huge:   parte do RSS coberta por huge pages (AnonHugePages/PmdMapped).\n");
+    printf("• Resid.: páginas residentes / tamanho virtual da região.\n");
+    printf("• Dens2M: páginas residentes / páginas das janelas de 2 MB tocadas;\n");
+    printf("          baixa densidade = memória espalhada, ruim para THP.\n");
+    printf("===========================================================\n");
+
+    free(ponteiro_heap);
+    return EXIT_SUCCESS;
+}
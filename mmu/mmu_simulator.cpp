@@ -1,9 +1,68 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
 
-#define PAGE_SIZE 1024        // 1 KB por página
-#define NUM_PAGES 8           // Total de páginas lógicas
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "../trace/page_trace.h"
+
+// =============================================================
+// Geometria da MMU em tempo de compilação
+// -------------------------------------------------------------
+// Tamanho de página, largura do endereço virtual e número de
+// níveis são parâmetros de template: todas as divisões e restos
+// da tradução viram deslocamentos e máscaras constantes, e o laço
+// de níveis é desenrolado pelo compilador.
+//
+// Cada tabela ocupa uma página de PTEs de 8 bytes, então cada
+// nível indexa OFFSET_BITS - 3 bits (9 com 4 KB, como no x86-64;
+// 11 com 16 KB e 13 com 64 KB, como no ARM64). O nível do topo
+// fica com os bits que sobram.
+// =============================================================
+
+constexpr unsigned exact_log2(uint64_t v) {
+    return v <= 1 ? 0 : 1 + exact_log2(v >> 1);
+}
+
+template <uint64_t PageSize, unsigned VaBits, unsigned Levels>
+struct Geometry {
+    static_assert(PageSize >= 1024 && (PageSize & (PageSize - 1)) == 0, "Página deve ser potência de 2 >= 1 KB");
+    static_assert(VaBits <= 64, "Endereço virtual de no máximo 64 bits");
+
+    static constexpr uint64_t PAGE_BYTES = PageSize;
+    static constexpr unsigned VA_BITS = VaBits;
+    static constexpr unsigned LEVELS = Levels;
+    static constexpr unsigned OFFSET_BITS = exact_log2(PageSize);
+    static constexpr unsigned VPN_BITS = VaBits - OFFSET_BITS;
+    static constexpr unsigned INDEX_BITS = OFFSET_BITS - 3;
+    static constexpr unsigned TOP_BITS = VPN_BITS - (Levels - 1) * INDEX_BITS;
+
+    static_assert(Levels >= 1 && VaBits > OFFSET_BITS && (Levels - 1) * INDEX_BITS < VPN_BITS &&
+                  VPN_BITS <= Levels * INDEX_BITS, "Número de níveis incompatível com página e endereço");
+
+    static constexpr uint64_t OFFSET_MASK = PageSize - 1;
+    static constexpr uint64_t VA_MASK = VaBits == 64 ? ~0ull : (1ull << VaBits) - 1;
+
+    static constexpr uint64_t page(uint64_t va) { return va >> OFFSET_BITS; }
+    static constexpr uint64_t offset(uint64_t va) { return va & OFFSET_MASK; }
+
+    /** Índice do nível 'level' (0 = tabela folha, LEVELS - 1 = raiz). */
+    static constexpr uint64_t index(uint64_t va, unsigned level) {
+        return (va >> (OFFSET_BITS + level * INDEX_BITS)) &
+               ((1ull << (level == Levels - 1 ? TOP_BITS : INDEX_BITS)) - 1);
+    }
+};
+
+// MMU didática: páginas de 1 KB e 8 páginas lógicas (VA de 13 bits, um nível)
+using DidacticGeometry = Geometry<1024, 13, 1>;
+
+constexpr int PAGE_SIZE = (int) DidacticGeometry::PAGE_BYTES;       // 1 KB por página
+constexpr int NUM_PAGES = 1 << DidacticGeometry::VPN_BITS;          // Total de páginas lógicas
 #define INVALID_PAGE -1       // Valor que representa page fault
 
 // Tabela de páginas simulando a MMU
@@ -25,8 +84,8 @@ bool is_valid_page(int page_num) {
  * @return endereço físico em decimal, ou -1 em caso de page fault
  */
 int translate_address(int logical_address) {
-    int page_number = logical_address / PAGE_SIZE;
-    int offset = logical_address % PAGE_SIZE;
+    int page_number = (int) DidacticGeometry::page((uint64_t) logical_address);
+    int offset = (int) DidacticGeometry::offset((uint64_t) logical_address);
 
     if (!is_valid_page(page_number)) {
         fprintf(stderr, "[ERRO] Número de página fora do intervalo válido (0-%d)\n", NUM_PAGES - 1);
@@ -71,9 +130,484 @@ void print_page_table() {
     printf("-------------------------------\n");
 }
 
-int main(void) {
+// =============================================================
+// MMU multinível: template x geometria em tempo de execução
+// =============================================================
+
+#define PTE_PRESENT 1ull   // bit 0 da PTE; os demais guardam o número do quadro
+
+/**
+ * @brief Tabelas de páginas em "memória física" simulada.
+ *
+ * A tabela t ocupa as entradas [t << index_bits, (t + 1) << index_bits)
+ * do vetor 'tables'; a raiz é a tabela 0 (o papel do CR3/TTBR). Uma PTE
+ * presente aponta para a próxima tabela ou, na folha, para o quadro de dados.
+ * O mapeamento usa a geometria em tempo de execução: só a tradução é quente.
+ */
+class MmuBase {
+public:
+    MmuBase(uint64_t page_size, unsigned va_bits, unsigned levels)
+        : page_size(page_size), va_bits(va_bits), levels(levels), offset_bits(exact_log2(page_size)),
+          index_bits(offset_bits - 3) {
+        new_table();
+    }
+    virtual ~MmuBase() = default;
+
+    /** Mapeia a página de 'va' no quadro 'frame', criando as tabelas intermediárias. */
+    void map(uint64_t va, uint64_t frame) {
+        uint64_t table = 0;
+        for (unsigned level = levels; level-- > 0;) {
+            uint64_t slot = (table << index_bits) | level_index(va, level);
+            if (level == 0) {
+                tables[slot] = (frame << 1) | PTE_PRESENT;
+            } else {
+                if (!(tables[slot] & PTE_PRESENT))
+                    tables[slot] = (new_table() << 1) | PTE_PRESENT;
+                table = tables[slot] >> 1;
+            }
+        }
+    }
+
+    /** Percorre a tabela mostrando o índice e a PTE de cada nível. */
+    void explain(uint64_t va) const {
+        printf("\nVA 0x%llx\n", (unsigned long long) va);
+        if (va_bits < 64 && (va >> va_bits)) {
+            printf("  ❌ Endereço fora do espaço de %u bits\n", va_bits);
+            return;
+        }
+        uint64_t table = 0;
+        for (unsigned level = levels; level-- > 0;) {
+            uint64_t idx = level_index(va, level);
+            uint64_t pte = tables[(table << index_bits) | idx];
+            printf("  Nível %u: tabela %4llu índice %5llu → PTE 0x%llx\n", levels - level,
+                   (unsigned long long) table, (unsigned long long) idx, (unsigned long long) pte);
+            if (!(pte & PTE_PRESENT)) {
+                printf("  ⚠️  Page Fault no nível %u\n", levels - level);
+                return;
+            }
+            table = pte >> 1;
+        }
+        uint64_t pa = (table << offset_bits) | (va & (page_size - 1));
+        printf("  ✅ Quadro %llu + deslocamento 0x%llx → PA 0x%llx\n", (unsigned long long) table,
+               (unsigned long long) (va & (page_size - 1)), (unsigned long long) pa);
+    }
+
+    virtual bool translate(uint64_t va, uint64_t *pa) const = 0;
+
+    /** Traduz 'n' endereços; devolve a soma dos PAs (checagem) e conta as faltas. */
+    virtual uint64_t translate_batch(const uint64_t *va, size_t n, size_t *faults) const = 0;
+
+    size_t table_count() const { return tables.size() >> index_bits; }
+
+    const uint64_t page_size;
+    const unsigned va_bits, levels, offset_bits, index_bits;
+
+protected:
+    std::vector<uint64_t> tables;
+
+    uint64_t level_index(uint64_t va, unsigned level) const {
+        unsigned bits = level == levels - 1 ? va_bits - offset_bits - (levels - 1) * index_bits : index_bits;
+        return (va >> (offset_bits + level * index_bits)) & ((1ull << bits) - 1);
+    }
+
+    uint64_t new_table() {
+        uint64_t t = table_count();
+        tables.resize(tables.size() + (1ull << index_bits), 0);
+        return t;
+    }
+};
+
+/**
+ * @brief MMU especializada: G fornece todas as constantes da tradução.
+ */
+template <class G>
+class Mmu final : public MmuBase {
+public:
+    Mmu() : MmuBase(G::PAGE_BYTES, G::VA_BITS, G::LEVELS) {}
+
+    inline bool walk(uint64_t va, uint64_t *pa) const {
+        if (va & ~G::VA_MASK) return false;
+        const uint64_t *t = tables.data();
+        uint64_t table = 0;
+        for (unsigned level = G::LEVELS; level-- > 0;) {
+            uint64_t pte = t[(table << G::INDEX_BITS) | G::index(va, level)];
+            if (!(pte & PTE_PRESENT)) return false;
+            table = pte >> 1;
+        }
+        *pa = (table << G::OFFSET_BITS) | G::offset(va);
+        return true;
+    }
+
+    bool translate(uint64_t va, uint64_t *pa) const override { return walk(va, pa); }
+
+    uint64_t translate_batch(const uint64_t *va, size_t n, size_t *faults) const override {
+        uint64_t sum = 0, pa;
+        size_t f = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (walk(va[i], &pa)) sum += pa;
+            else f++;
+        }
+        *faults = f;
+        return sum;
+    }
+};
+
+/**
+ * @brief Mesma tabela, geometria em variáveis: a tradução de translate_address
+ * (VA / PAGE_SIZE, VA % PAGE_SIZE, quadro * PAGE_SIZE) generalizada para vários níveis.
+ */
+class RuntimeMmu final : public MmuBase {
+public:
+    RuntimeMmu(uint64_t page_size, unsigned va_bits, unsigned levels)
+        : MmuBase(page_size, va_bits, levels), entries(1ull << index_bits),
+          va_limit(va_bits == 64 ? ~0ull : (1ull << va_bits) - 1) {
+        uint64_t d = 1;
+        for (unsigned level = 0; level < levels; level++, d *= entries)
+            divisor[level] = d;
+    }
+
+    inline bool walk(uint64_t va, uint64_t *pa) const {
+        if (va > va_limit) return false;
+        uint64_t page_number = va / page_size;
+        uint64_t offset = va % page_size;
+        uint64_t table = 0;
+        for (unsigned level = levels; level-- > 0;) {
+            uint64_t pte = tables[table * entries + (page_number / divisor[level]) % entries];
+            if (!(pte & PTE_PRESENT)) return false;
+            table = pte >> 1;
+        }
+        *pa = table * page_size + offset;
+        return true;
+    }
+
+    bool translate(uint64_t va, uint64_t *pa) const override { return walk(va, pa); }
+
+    uint64_t translate_batch(const uint64_t *va, size_t n, size_t *faults) const override {
+        uint64_t sum = 0, pa;
+        size_t f = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (walk(va[i], &pa)) sum += pa;
+            else f++;
+        }
+        *faults = f;
+        return sum;
+    }
+
+private:
+    const uint64_t entries, va_limit;
+    uint64_t divisor[64];
+};
+
+// =============================================================
+// Registro de geometrias pré-instanciadas
+// =============================================================
+
+struct MmuConfig {
+    const char *name;
+    uint64_t page_size;
+    unsigned va_bits;
+    unsigned levels;
+    std::unique_ptr<MmuBase> (*create)();
+};
+
+template <uint64_t PageSize, unsigned VaBits, unsigned Levels>
+std::unique_ptr<MmuBase> create_mmu() {
+    return std::unique_ptr<MmuBase>(new Mmu<Geometry<PageSize, VaBits, Levels>>());
+}
+
+#define MMU_CONFIG(nome, pagina, bits, niveis) {nome, pagina, bits, niveis, create_mmu<pagina, bits, niveis>}
+
+static const MmuConfig MMU_REGISTRY[] = {
+    MMU_CONFIG("1K / 32 bits", 1024, 32, 4),
+    MMU_CONFIG("1K / 48 bits", 1024, 48, 6),
+    MMU_CONFIG("1K / 57 bits", 1024, 57, 7),
+    MMU_CONFIG("4K / 32 bits", 4096, 32, 3),       // x86 PAE
+    MMU_CONFIG("4K / 48 bits", 4096, 48, 4),       // x86-64, ARM64 4K
+    MMU_CONFIG("4K / 57 bits", 4096, 57, 5),       // x86-64 LA57
+    MMU_CONFIG("16K / 32 bits", 16384, 32, 2),
+    MMU_CONFIG("16K / 48 bits", 16384, 48, 4),     // ARM64 16K (Apple M1)
+    MMU_CONFIG("16K / 57 bits", 16384, 57, 4),
+    MMU_CONFIG("64K / 32 bits", 65536, 32, 2),
+    MMU_CONFIG("64K / 48 bits", 65536, 48, 3),     // ARM64 64K
+    MMU_CONFIG("64K / 57 bits", 65536, 57, 4),
+};
+
+#define NUM_MMU_CONFIGS (int) (sizeof(MMU_REGISTRY) / sizeof(MMU_REGISTRY[0]))
+
+/**
+ * @brief Busca a configuração pré-instanciada para a geometria pedida.
+ * @return NULL se a combinação não foi instanciada
+ */
+const MmuConfig *find_mmu_config(uint64_t page_size, unsigned va_bits) {
+    for (int i = 0; i < NUM_MMU_CONFIGS; i++)
+        if (MMU_REGISTRY[i].page_size == page_size && MMU_REGISTRY[i].va_bits == va_bits)
+            return &MMU_REGISTRY[i];
+    return NULL;
+}
+
+/** Aceita "4096", "4K", "64k". */
+uint64_t parse_page_size(const char *text) {
+    char *end;
+    uint64_t v = strtoull(text, &end, 10);
+    if (*end == 'K' || *end == 'k') v *= 1024;
+    return v;
+}
+
+void print_mmu_registry() {
+    printf("\nGeometrias disponíveis (índices do nível raiz → folha + deslocamento)\n");
+    printf("---------------------------------------------------------------\n");
+    for (int i = 0; i < NUM_MMU_CONFIGS; i++) {
+        const MmuConfig *c = &MMU_REGISTRY[i];
+        unsigned offset_bits = exact_log2(c->page_size), index_bits = offset_bits - 3;
+        unsigned top = c->va_bits - offset_bits - (c->levels - 1) * index_bits;
+        printf("%-14s | %u níveis | %2u", c->name, c->levels, top);
+        for (unsigned l = 1; l < c->levels; l++) printf("+%u", index_bits);
+        printf(" + %u\n", offset_bits);
+    }
+    printf("---------------------------------------------------------------\n");
+}
+
+/**
+ * @brief Maior 'pages' para map_demo_regions sem que as regiões se sobreponham.
+ *
+ * O código começa em 4 MB e o heap em 256 MB; o mmap começa no meio do espaço
+ * e a pilha desce do topo. Com VA de 32 bits e páginas de 64 KB, a região de
+ * código esgota o intervalo até o heap com pouco mais de 16 mil páginas.
+ */
+uint64_t max_demo_pages(uint64_t page_size, unsigned va_bits) {
+    uint64_t span = va_bits == 64 ? ~0ull : (1ull << va_bits);
+    uint64_t mmap_base = (span / 2) & ~(page_size - 1);
+    uint64_t region = (1ull << 28) - (1ull << 22);                  // código até o heap
+    if (mmap_base - (1ull << 28) < region) region = mmap_base - (1ull << 28);
+    if ((span - page_size - mmap_base) / 2 < region) region = (span - page_size - mmap_base) / 2;
+    return region / page_size * 4;
+}
+
+/**
+ * @brief Mapeia 'pages' páginas em quatro regiões típicas: código, heap, mmap e pilha.
+ * @return VA base de cada região em 'bases' (regiões de pages / 4 páginas)
+ */
+void map_demo_regions(MmuBase *mmu, uint64_t pages, uint64_t bases[4]) {
+    uint64_t span = mmu->va_bits == 64 ? ~0ull : (1ull << mmu->va_bits);
+    uint64_t region = (pages / 4) * mmu->page_size;
+    bases[0] = 1ull << 22;                                   // código (4 MB)
+    bases[1] = 1ull << 28;                                   // heap (256 MB)
+    bases[2] = (span / 2) & ~(mmu->page_size - 1);           // bibliotecas e mmap
+    bases[3] = (span - region - mmu->page_size) & ~(mmu->page_size - 1);   // pilha, abaixo do topo
+
+    uint64_t frame = 0;
+    for (int r = 0; r < 4; r++)
+        for (uint64_t p = 0; p < pages / 4; p++)
+            mmu->map(bases[r] + p * mmu->page_size, frame++);
+}
+
+/**
+ * @brief Modo --geometria: traduz VAs informados numa geometria escolhida em tempo de execução.
+ */
+int explain_geometry(const char *page_text, const char *bits_text, char **vas, int num_vas) {
+    uint64_t page_size = parse_page_size(page_text);
+    const MmuConfig *config = find_mmu_config(page_size, (unsigned) atoi(bits_text));
+    if (!config) {
+        fprintf(stderr, "[ERRO] Geometria %s / %s bits não instanciada.\n", page_text, bits_text);
+        print_mmu_registry();
+        return 1;
+    }
+
+    std::unique_ptr<MmuBase> mmu = config->create();
+    uint64_t bases[4];
+    map_demo_regions(mmu.get(), 64, bases);
+
+    printf("Geometria %s: %u níveis, %zu tabelas alocadas\n", config->name, config->levels, mmu->table_count());
+    printf("Regiões mapeadas (16 páginas cada): código 0x%llx | heap 0x%llx | mmap 0x%llx | pilha 0x%llx\n",
+           (unsigned long long) bases[0], (unsigned long long) bases[1], (unsigned long long) bases[2],
+           (unsigned long long) bases[3]);
+
+    if (num_vas == 0) {
+        for (int r = 0; r < 4; r++) mmu->explain(bases[r] + 0x123);
+        mmu->explain(bases[1] + 64 * page_size);   // logo após o heap: não mapeado
+    }
+    for (int i = 0; i < num_vas; i++)
+        mmu->explain(strtoull(vas[i], NULL, 0));
+    return 0;
+}
+
+/**
+ * @brief Modo --traco: traduz em lote um traço .pgt numa geometria do registro.
+ *
+ * A tabela começa vazia e é preenchida sob demanda: o lote inteiro passa por
+ * translate_batch (o trecho medido) e, se houve faltas, as páginas ainda não
+ * mapeadas ganham o próximo quadro livre, como na primeira falta de um processo.
+ *
+ * @return 0 em caso de sucesso, 1 se a geometria não existe ou o traço não pôde ser lido
+ */
+int simulate_trace(const char *path, const char *page_text, const char *bits_text, long max_refs) {
+    uint64_t page_size = parse_page_size(page_text);
+    const MmuConfig *config = find_mmu_config(page_size, (unsigned) atoi(bits_text));
+    if (!config) {
+        fprintf(stderr, "[ERRO] Geometria %s / %s bits não instanciada.\n", page_text, bits_text);
+        print_mmu_registry();
+        return 1;
+    }
+    LeitorTraco *trace = traco_abrir(path);
+    if (!trace) return 1;
+
+    std::unique_ptr<MmuBase> mmu = config->create();
+    uint64_t batch[4096], pa, frames = 0;
+    long total = 0, faults = 0, out_of_range = 0;
+    size_t n;
+    double seconds = 0;
+
+    while (total < max_refs && (n = traco_ler(trace, batch, 4096)) > 0) {
+        if ((long) n > max_refs - total) n = (size_t) (max_refs - total);
+        size_t batch_faults;
+        auto start = std::chrono::steady_clock::now();
+        mmu->translate_batch(batch, n, &batch_faults);
+        seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // Refaz só os endereços do lote que faltaram: repetições da mesma página já acham o mapeamento
+        for (size_t i = 0; i < n && batch_faults > 0; i++) {
+            if (mmu->translate(batch[i], &pa)) continue;
+            faults++;
+            if (config->va_bits < 64 && (batch[i] >> config->va_bits))
+                out_of_range++;            // nunca mapeável nesta geometria
+            else
+                mmu->map(batch[i], frames++);
+        }
+        total += (long) n;
+    }
+    traco_fechar(trace);
+
+    printf("\n--- Tradução do traço %s (geometria %s, %u níveis) ---\n", path, config->name, config->levels);
+    printf("Referências:          %ld (decodificador %s)\n", total, traco_nome_decodificador());
+    printf("Páginas distintas:    %llu (%.1f MB mapeados)\n", (unsigned long long) frames,
+           (double) frames * (double) page_size / (1024.0 * 1024.0));
+    printf("Page faults:          %ld (%.4f%%)\n", faults, total ? 100.0 * faults / total : 0.0);
+    printf("Fora dos %2u bits:     %ld\n", config->va_bits, out_of_range);
+    printf("Tabelas de páginas:   %zu (%.1f KB)\n", mmu->table_count(),
+           (double) mmu->table_count() * (double) page_size / 1024.0);
+    printf("Tradução:             %.3f s (%.2f ns por referência)\n", seconds,
+           total ? seconds * 1e9 / (double) total : 0.0);
+    return 0;
+}
+
+// =============================================================
+// Benchmark: custo por tradução de cada geometria
+// =============================================================
+
+static uint64_t rng_mmu(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+template <class F>
+static double time_ns_per_translation(F body, size_t n, int repeats) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; r++) body();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ((double) n * repeats);
+}
+
+/**
+ * @brief Mede template (lote), divisão/resto em tempo de execução (lote) e
+ * template chamado por função virtual a cada endereço.
+ */
+void benchmark_mmu(size_t translations, uint64_t pages) {
+    printf("=============================================\n");
+    printf("  Custo por tradução de cada geometria\n");
+    printf("=============================================\n");
+    printf("%zu traduções por rodada | %llu páginas mapeadas em 4 regiões | 5%% de VAs não mapeados\n\n",
+           translations, (unsigned long long) pages);
+    printf("%-14s | %6s | %7s | %12s | %12s | %12s | %6s\n", "Geometria", "Niveis", "Tabelas", "Template ns",
+           "Div/mod ns", "Virtual ns", "Ganho");
+    printf("------------------------------------------------------------------------------------------\n");
+
+    std::vector<uint64_t> vas(translations);
+    volatile uint64_t sink = 0;
+
+    for (int i = 0; i < NUM_MMU_CONFIGS; i++) {
+        const MmuConfig *c = &MMU_REGISTRY[i];
+        std::unique_ptr<MmuBase> fast = c->create();
+        RuntimeMmu slow(c->page_size, c->va_bits, c->levels);
+        uint64_t bases[4];
+        map_demo_regions(fast.get(), pages, bases);
+        map_demo_regions(&slow, pages, bases);
+
+        uint64_t state = 0x9E3779B97F4A7C15ull;
+        uint64_t span_mask = c->va_bits == 64 ? ~0ull : (1ull << c->va_bits) - 1;
+        for (size_t k = 0; k < translations; k++) {
+            uint64_t r = rng_mmu(&state);
+            if (r % 20 == 0)
+                vas[k] = (r >> 7) & span_mask;
+            else
+                vas[k] = bases[r % 4] + ((r >> 8) % (pages / 4)) * c->page_size + ((r >> 40) & (c->page_size - 1));
+        }
+
+        size_t faults_fast, faults_slow;
+        uint64_t sum_fast = fast->translate_batch(vas.data(), translations, &faults_fast);
+        uint64_t sum_slow = slow.translate_batch(vas.data(), translations, &faults_slow);
+        if (sum_fast != sum_slow || faults_fast != faults_slow) {
+            fprintf(stderr, "[ERRO] %s: template e div/mod divergem\n", c->name);
+            return;
+        }
+
+        const MmuBase *fast_ptr = fast.get();
+        const uint64_t *va = vas.data();
+        int repeats = 5;
+        size_t faults;
+        double t_template = time_ns_per_translation([&] { sink += fast_ptr->translate_batch(va, translations, &faults); },
+                                                    translations, repeats);
+        double t_runtime = time_ns_per_translation([&] { sink += slow.translate_batch(va, translations, &faults); },
+                                                   translations, repeats);
+        double t_virtual = time_ns_per_translation([&] {
+            uint64_t pa, sum = 0;
+            for (size_t k = 0; k < translations; k++)
+                if (fast_ptr->translate(va[k], &pa)) sum += pa;
+            sink += sum;
+        }, translations, repeats);
+
+        printf("%-14s | %6u | %7zu | %12.2f | %12.2f | %12.2f | %5.1fx\n", c->name, c->levels, fast->table_count(),
+               t_template, t_runtime, t_virtual, t_runtime / t_template);
+    }
+    printf("------------------------------------------------------------------------------------------\n");
+    printf("Template: deslocamentos e máscaras constantes, níveis desenrolados (despacho virtual por lote).\n");
+    printf("Div/mod: a mesma tabela com VA / tamanho e %% entradas em variáveis, como em translate_address.\n");
+    printf("Virtual: o template chamado por função virtual a cada endereço (sem inlining no laço).\n");
+}
+
+int main(int argc, char **argv) {
     int logical_address;
 
+    // Geometrias multinível: --geometrias | --geometria <pagina> <bits_va> [va...] | --bench [traducoes] [paginas]
+    //                       | --traco arquivo.pgt [pagina] [bits_va] [max_refs]
+    if (argc > 1 && strcmp(argv[1], "--geometrias") == 0) {
+        print_mmu_registry();
+        return 0;
+    }
+    if (argc > 3 && strcmp(argv[1], "--geometria") == 0)
+        return explain_geometry(argv[2], argv[3], argv + 4, argc - 4);
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        long translations = argc > 2 ? atol(argv[2]) : 2000000;
+        long pages = argc > 3 ? atol(argv[3]) : 4096;
+        // Todas as geometrias mapeiam as mesmas páginas: vale o limite da mais apertada
+        uint64_t max_pages = ~0ull;
+        for (int i = 0; i < NUM_MMU_CONFIGS; i++) {
+            uint64_t m = max_demo_pages(MMU_REGISTRY[i].page_size, MMU_REGISTRY[i].va_bits);
+            if (m < max_pages) max_pages = m;
+        }
+        if (translations < 1 || pages < 4 || (uint64_t) pages > max_pages) {
+            fprintf(stderr, "Uso: %s --bench [traducoes] [paginas (4-%llu)]\n", argv[0],
+                    (unsigned long long) max_pages);
+            return 1;
+        }
+        benchmark_mmu((size_t) translations, (uint64_t) pages);
+        return 0;
+    }
+    if (argc > 2 && strcmp(argv[1], "--traco") == 0)
+        return simulate_trace(argv[2], argc > 3 ? argv[3] : "4K", argc > 4 ? argv[4] : "48",
+                              argc > 5 ? atol(argv[5]) : __LONG_MAX__);
+
     printf("=============================================\n");
     printf("  Simulador Simplificado de MMU (Memory Unit)\n");
     printf("=============================================\n");
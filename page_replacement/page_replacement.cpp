@@ -21,6 +21,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+
+#include "../trace/page_trace.h"
 
 #define MAX_REF 32
 #define MAX_FRAMES 10
@@ -156,11 +159,1078 @@ int simulate_LRU(int *refs, int num_refs, int num_frames) {
     return page_faults;
 }
 
+// =============================================================
+// MULTIPROCESSO — vários traços disputando um pool de quadros
+// =============================================================
+//
+//  Cada processo tem seu próprio traço de referências; um escalonador
+//  round-robin intercala os traços sobre um único pool físico. Uma
+//  falta bloqueia o processo enquanto o disco (servidor único, FIFO)
+//  carrega a página, e outro processo pronto usa a CPU nesse tempo.
+//
+//  Políticas de alocação comparadas:
+//   • LRU global      → vítima é a página menos usada de qualquer processo.
+//   • Local fixa      → cada processo recebe num_frames / num_procs quadros.
+//   • Working set     → mantém as páginas usadas nos últimos TAU acessos
+//                       do processo (Denning); suspende processos quando a
+//                       soma dos working sets não cabe na memória.
+//   • PFF             → Page-Fault Frequency: se o intervalo entre faltas é
+//                       longo, devolve as páginas não usadas desde a última
+//                       falta; se é curto, o processo cresce.
+// =============================================================
+
+#define MAX_PROCS 64
+#define JANELA_THRASHING 5000   // ticks por janela de detecção de thrashing
+
+typedef enum {
+    POL_GLOBAL_LRU,
+    POL_LOCAL_FIXA,
+    POL_WORKING_SET,
+    POL_PFF,
+    NUM_POLITICAS
+} Politica;
+
+static const char *NOMES_POLITICA[NUM_POLITICAS] = {
+    "LRU global", "Local fixa", "Working set", "PFF"
+};
+
+typedef struct {
+    int num_procs;
+    int num_frames;
+    int refs_por_proc;
+    int quantum;            // referências por fatia de CPU
+    int latencia_disco;     // ticks para carregar uma página
+    int tau;                // janela do working set (tempo virtual do processo)
+    int pff_limiar;         // intervalo entre faltas que separa "encolher" de "crescer"
+} ConfigMulti;
+
+typedef struct {
+    int pid;
+    int page;
+    long last_use;          // tick global do último acesso
+    long last_use_virt;     // tempo virtual do processo no último acesso
+    bool valid;
+} FrameCompartilhado;
+
+typedef struct {
+    int *refs;
+    int num_refs;
+    int num_pages;
+    int *page_to_frame;     // -1 = não residente
+
+    int pc;
+    int residentes;
+    int cota;               // só usada pela alocação local fixa
+    long tempo_virtual;
+    long ultima_falta_virt;
+    long pronto_em;         // tick em que a E/S pendente termina
+    bool suspenso;
+    bool terminado;
+    int ws_salvo;           // residentes no momento da suspensão
+
+    long faltas;
+    long suspensoes;
+    long soma_residentes;   // para a média de quadros enquanto executa
+    long fim;
+} Processo;
+
+typedef struct {
+    ConfigMulti cfg;
+    Politica politica;
+    FrameCompartilhado *frames;
+    int *livres;            // pilha de quadros livres
+    int num_livres;
+    Processo procs[MAX_PROCS];
+
+    long tick;
+    long disco_livre_em;
+
+    // Métricas globais e da janela de thrashing corrente
+    long ticks_cpu, ticks_disco;
+    long janela_cpu, janela_disco, janela_inicio;
+    int janelas, janelas_thrashing;
+    long primeira_janela_thrashing;
+    long fim_aquecimento;   // -1 enquanto algum processo não completou sua primeira fatia
+} SimMulti;
+
+/**
+ * @brief Gerador congruencial próprio: traços idênticos em qualquer plataforma.
+ */
+static unsigned int rng_multi(unsigned int *estado) {
+    *estado = *estado * 1103515245u + 12345u;
+    return (*estado >> 16) & 0x7FFF;
+}
+
+/**
+ * @brief Gera um traço com fases de localidade (99,8% dos acessos na localidade).
+ */
+void gerar_traco(Processo *p, int num_refs, int localidade, unsigned int semente) {
+    unsigned int estado = semente;
+    p->num_pages = 64 + (int) (rng_multi(&estado) % 192);
+    p->num_refs = num_refs;
+    p->refs = (int *) malloc(sizeof(int) * num_refs);
+    p->page_to_frame = (int *) malloc(sizeof(int) * p->num_pages);
+    if (!p->refs || !p->page_to_frame) {
+        perror("Falha ao alocar traço");
+        exit(EXIT_FAILURE);
+    }
+
+    int i = 0;
+    while (i < num_refs) {
+        int fase = 2000 + (int) (rng_multi(&estado) % 8000);
+        int base = (int) (rng_multi(&estado) % (p->num_pages - localidade));
+        for (int j = 0; j < fase && i < num_refs; j++, i++) {
+            if (rng_multi(&estado) % 500 != 0)
+                p->refs[i] = base + (int) (rng_multi(&estado) % localidade);
+            else
+                p->refs[i] = (int) (rng_multi(&estado) % p->num_pages);
+        }
+    }
+}
+
+// -------------------------------------------------------------
+// Gerência do pool de quadros
+// -------------------------------------------------------------
+
+static void liberar_quadro(SimMulti *s, int f) {
+    FrameCompartilhado *fr = &s->frames[f];
+    Processo *dono = &s->procs[fr->pid];
+    dono->page_to_frame[fr->page] = -1;
+    dono->residentes--;
+    fr->valid = false;
+    s->livres[s->num_livres++] = f;
+}
+
+static void liberar_processo(SimMulti *s, int pid) {
+    for (int f = 0; f < s->cfg.num_frames; f++)
+        if (s->frames[f].valid && s->frames[f].pid == pid)
+            liberar_quadro(s, f);
+}
+
+/**
+ * @brief Quadro menos recentemente usado (de um processo, ou de todos se pid = -1).
+ */
+static int vitima_lru(const SimMulti *s, int pid) {
+    int vitima = -1;
+    long menor = __LONG_MAX__;
+    for (int f = 0; f < s->cfg.num_frames; f++) {
+        const FrameCompartilhado *fr = &s->frames[f];
+        if (fr->valid && (pid < 0 || fr->pid == pid) && fr->last_use < menor) {
+            menor = fr->last_use;
+            vitima = f;
+        }
+    }
+    return vitima;
+}
+
+/**
+ * @brief Working set: devolve as páginas fora da janela TAU do processo.
+ */
+static void aparar_working_set(SimMulti *s, int pid) {
+    Processo *p = &s->procs[pid];
+    for (int f = 0; f < s->cfg.num_frames; f++) {
+        FrameCompartilhado *fr = &s->frames[f];
+        if (fr->valid && fr->pid == pid && fr->last_use_virt <= p->tempo_virtual - s->cfg.tau)
+            liberar_quadro(s, f);
+    }
+}
+
+/**
+ * @brief Controle de carga: suspende o maior processo ativo (exceto 'atual').
+ * @return true se algum processo foi suspenso
+ */
+static bool suspender_processo(SimMulti *s, int atual) {
+    int escolhido = -1;
+    for (int i = 0; i < s->cfg.num_procs; i++) {
+        Processo *p = &s->procs[i];
+        if (i == atual || p->terminado || p->suspenso || p->residentes == 0)
+            continue;
+        if (escolhido < 0 || p->residentes > s->procs[escolhido].residentes)
+            escolhido = i;
+    }
+    if (escolhido < 0)
+        return false;
+
+    Processo *p = &s->procs[escolhido];
+    p->ws_salvo = p->residentes;
+    p->suspenso = true;
+    p->suspensoes++;
+    liberar_processo(s, escolhido);
+    return true;
+}
+
+/**
+ * @brief Reativa suspensos cujo working set salvo cabe nos quadros livres.
+ */
+static void reativar_suspensos(SimMulti *s) {
+    bool algum_ativo = false;
+    for (int i = 0; i < s->cfg.num_procs; i++)
+        if (!s->procs[i].terminado && !s->procs[i].suspenso)
+            algum_ativo = true;
+
+    for (int i = 0; i < s->cfg.num_procs; i++) {
+        Processo *p = &s->procs[i];
+        if (!p->suspenso)
+            continue;
+        // Sem nenhum processo ativo, o primeiro suspenso volta de qualquer forma
+        if (p->ws_salvo <= s->num_livres || !algum_ativo) {
+            p->suspenso = false;
+            algum_ativo = true;
+        }
+    }
+}
+
+/**
+ * @brief Escolhe o quadro que receberá a página faltante do processo 'pid'.
+ */
+static int obter_quadro(SimMulti *s, int pid) {
+    Processo *p = &s->procs[pid];
+    int vitima;
+
+    switch (s->politica) {
+        case POL_GLOBAL_LRU:
+            if (s->num_livres > 0) break;
+            liberar_quadro(s, vitima_lru(s, -1));
+            break;
+
+        case POL_LOCAL_FIXA:
+            if (p->residentes < p->cota && s->num_livres > 0) break;
+            vitima = vitima_lru(s, pid);
+            if (vitima < 0) {
+                // Cota zero (mais processos que quadros): o processo tem direito a ao
+                // menos um quadro, livre ou tomado do LRU global
+                if (s->num_livres > 0) break;
+                vitima = vitima_lru(s, -1);
+            }
+            liberar_quadro(s, vitima);
+            break;
+
+        case POL_WORKING_SET:
+        case POL_PFF:
+            if (s->politica == POL_WORKING_SET) {
+                aparar_working_set(s, pid);
+            } else if (p->tempo_virtual - p->ultima_falta_virt > s->cfg.pff_limiar) {
+                // Faltas raras → encolhe: sai tudo que não foi usado desde a última falta
+                for (int f = 0; f < s->cfg.num_frames; f++) {
+                    FrameCompartilhado *fr = &s->frames[f];
+                    if (fr->valid && fr->pid == pid && fr->last_use_virt < p->ultima_falta_virt)
+                        liberar_quadro(s, f);
+                }
+            }
+            if (s->num_livres > 0) break;
+            // Memória esgotada: suspende outro processo; se não houver, substitui localmente
+            if (suspender_processo(s, pid)) break;
+            vitima = vitima_lru(s, pid);
+            liberar_quadro(s, vitima >= 0 ? vitima : vitima_lru(s, -1));
+            break;
+
+        default:
+            break;
+    }
+    return s->livres[--s->num_livres];
+}
+
+// -------------------------------------------------------------
+// Métricas de thrashing (CPU ociosa enquanto o disco satura)
+// -------------------------------------------------------------
+
+/**
+ * @brief Partida a frio: todos os processos faltam ao mesmo tempo até carregar a
+ *        localidade inicial. Termina quando cada processo ativo completou uma fatia.
+ */
+static bool aquecido(SimMulti *s) {
+    if (s->fim_aquecimento >= 0)
+        return true;
+    for (int i = 0; i < s->cfg.num_procs; i++) {
+        const Processo *p = &s->procs[i];
+        if (!p->terminado && !p->suspenso && p->tempo_virtual < s->cfg.quantum)
+            return false;
+    }
+    s->fim_aquecimento = s->tick;
+    return true;
+}
+
+static void contabilizar(SimMulti *s, long ticks, bool cpu_ocupada) {
+    while (ticks > 0) {
+        long restante_janela = s->janela_inicio + JANELA_THRASHING - s->tick;
+        long passo = ticks < restante_janela ? ticks : restante_janela;
+
+        long disco = s->disco_livre_em - s->tick;
+        disco = disco < 0 ? 0 : (disco > passo ? passo : disco);
+        if (cpu_ocupada) {
+            s->ticks_cpu += passo;
+            s->janela_cpu += passo;
+        }
+        s->ticks_disco += disco;
+        s->janela_disco += disco;
+        s->tick += passo;
+        ticks -= passo;
+
+        if (s->tick == s->janela_inicio + JANELA_THRASHING) {
+            // Thrashing: CPU útil abaixo de 50% com o disco acima de 90%.
+            // Janelas que começaram durante a partida a frio não contam.
+            bool conta = s->fim_aquecimento >= 0 && s->janela_inicio >= s->fim_aquecimento;
+            aquecido(s);
+            if (conta) s->janelas++;
+            if (conta && s->janela_cpu * 2 < JANELA_THRASHING && s->janela_disco * 10 > JANELA_THRASHING * 9) {
+                if (s->janelas_thrashing++ == 0)
+                    s->primeira_janela_thrashing = s->janela_inicio;
+            }
+            s->janela_inicio = s->tick;
+            s->janela_cpu = s->janela_disco = 0;
+        }
+    }
+}
+
+// -------------------------------------------------------------
+// Laço principal da simulação
+// -------------------------------------------------------------
+
+static bool pronto(const SimMulti *s, int pid) {
+    const Processo *p = &s->procs[pid];
+    return !p->terminado && !p->suspenso && p->pronto_em <= s->tick;
+}
+
+static int proximo_processo(const SimMulti *s, int atual) {
+    for (int k = 1; k <= s->cfg.num_procs; k++) {
+        int i = (atual + k + s->cfg.num_procs) % s->cfg.num_procs;
+        if (pronto(s, i))
+            return i;
+    }
+    return -1;
+}
+
+void simular_multiprocesso(SimMulti *s) {
+    const ConfigMulti *cfg = &s->cfg;
+    int ativos = cfg->num_procs;
+    int atual = -1, fatia = 0;
+
+    s->frames = (FrameCompartilhado *) calloc(cfg->num_frames, sizeof(FrameCompartilhado));
+    s->livres = (int *) malloc(sizeof(int) * cfg->num_frames);
+    if (!s->frames || !s->livres) {
+        perror("Falha ao alocar quadros");
+        exit(EXIT_FAILURE);
+    }
+    for (int f = cfg->num_frames - 1; f >= 0; f--)
+        s->livres[s->num_livres++] = f;
+
+    for (int i = 0; i < cfg->num_procs; i++) {
+        Processo *p = &s->procs[i];
+        for (int pg = 0; pg < p->num_pages; pg++)
+            p->page_to_frame[pg] = -1;
+        p->cota = cfg->num_frames / cfg->num_procs + (i < cfg->num_frames % cfg->num_procs ? 1 : 0);
+    }
+
+    while (ativos > 0) {
+        // Ponto de escalonamento: fim de fatia, bloqueio ou término
+        if (atual < 0 || fatia == 0 || !pronto(s, atual)) {
+            if (atual >= 0 && s->politica == POL_WORKING_SET && !s->procs[atual].terminado)
+                aparar_working_set(s, atual);
+            if (s->politica == POL_WORKING_SET || s->politica == POL_PFF)
+                reativar_suspensos(s);
+
+            int proximo = proximo_processo(s, atual);
+            if (proximo < 0) {
+                // Ninguém pronto: CPU ociosa até a próxima E/S terminar
+                long acorda = __LONG_MAX__;
+                for (int i = 0; i < cfg->num_procs; i++) {
+                    Processo *p = &s->procs[i];
+                    if (!p->terminado && !p->suspenso && p->pronto_em < acorda)
+                        acorda = p->pronto_em;
+                }
+                if (acorda == __LONG_MAX__ || acorda <= s->tick)
+                    acorda = s->tick + 1;
+                contabilizar(s, acorda - s->tick, false);
+                continue;
+            }
+            atual = proximo;
+            fatia = cfg->quantum;
+        }
+
+        // Executa uma referência do processo atual
+        Processo *p = &s->procs[atual];
+        int page = p->refs[p->pc++];
+        int f = p->page_to_frame[page];
+        p->tempo_virtual++;
+        p->soma_residentes += p->residentes;
+
+        if (f < 0) {
+            f = obter_quadro(s, atual);
+            p->page_to_frame[page] = f;
+            p->residentes++;
+            p->faltas++;
+            p->ultima_falta_virt = p->tempo_virtual;
+            s->frames[f].pid = atual;
+            s->frames[f].page = page;
+            s->frames[f].valid = true;
+
+            // Disco é um servidor único: a E/S entra na fila
+            long inicio = s->disco_livre_em > s->tick + 1 ? s->disco_livre_em : s->tick + 1;
+            s->disco_livre_em = inicio + cfg->latencia_disco;
+            p->pronto_em = s->disco_livre_em;
+            fatia = 0;
+        }
+        s->frames[f].last_use = s->tick;
+        s->frames[f].last_use_virt = p->tempo_virtual;
+
+        if (p->pc == p->num_refs) {
+            p->terminado = true;
+            p->fim = p->pronto_em > s->tick + 1 ? p->pronto_em : s->tick + 1;
+            liberar_processo(s, atual);
+            ativos--;
+            fatia = 0;
+        }
+        contabilizar(s, 1, true);
+        if (fatia > 0) fatia--;
+    }
+
+    // Espera a última E/S para fechar o tempo total
+    if (s->disco_livre_em > s->tick)
+        contabilizar(s, s->disco_livre_em - s->tick, false);
+
+    free(s->frames);
+    free(s->livres);
+}
+
+/**
+ * @brief Executa uma política sobre os traços e imprime o relatório por processo.
+ */
+long executar_politica(const ConfigMulti *cfg, Processo *modelos, Politica politica, bool detalhar) {
+    SimMulti *s = (SimMulti *) calloc(1, sizeof(SimMulti));
+    if (!s) {
+        perror("Falha ao alocar simulação");
+        exit(EXIT_FAILURE);
+    }
+    s->cfg = *cfg;
+    s->politica = politica;
+    s->fim_aquecimento = -1;
+    for (int i = 0; i < cfg->num_procs; i++) {
+        // Reaproveita os traços; zera o estado dinâmico
+        Processo *p = &s->procs[i];
+        p->refs = modelos[i].refs;
+        p->num_refs = modelos[i].num_refs;
+        p->num_pages = modelos[i].num_pages;
+        p->page_to_frame = modelos[i].page_to_frame;
+    }
+
+    simular_multiprocesso(s);
+
+    long refs = 0, faltas = 0, suspensoes = 0;
+    if (detalhar) {
+        printf("\n🔹 Política: %s\n", NOMES_POLITICA[politica]);
+        printf("------------------------------------------------------------\n");
+        printf("PID | Páginas |   Refs | Faltas | Taxa (%%) | Quadros médios | Suspensões | Fim (tick)\n");
+    }
+    for (int i = 0; i < cfg->num_procs; i++) {
+        Processo *p = &s->procs[i];
+        refs += p->num_refs;
+        faltas += p->faltas;
+        suspensoes += p->suspensoes;
+        if (detalhar) {
+            printf("%3d | %7d | %6d | %6ld | %8.2f | %14.1f | %10ld | %ld\n", i, p->num_pages, p->num_refs,
+                   p->faltas, 100.0 * p->faltas / p->num_refs, (double) p->soma_residentes / p->num_refs,
+                   p->suspensoes, p->fim);
+        }
+    }
+
+    double vazao = 1000.0 * refs / s->tick;
+    if (detalhar) {
+        printf("------------------------------------------------------------\n");
+        printf("Faltas totais: %ld (%.2f%%) | Suspensões: %ld\n", faltas, 100.0 * faltas / refs, suspensoes);
+        printf("Tempo total: %ld ticks | Vazão: %.1f refs/1000 ticks | CPU: %.1f%% | Disco: %.1f%%\n",
+               s->tick, vazao, 100.0 * s->ticks_cpu / s->tick, 100.0 * s->ticks_disco / s->tick);
+        if (s->fim_aquecimento >= 0)
+            printf("Partida a frio: até o tick %ld (fora da detecção de thrashing)\n", s->fim_aquecimento);
+        else
+            printf("Partida a frio: durou a simulação inteira (sem janelas avaliadas)\n");
+        if (s->janelas_thrashing > 0)
+            printf("⚠️  Thrashing em %d de %d janelas (início no tick %ld)\n", s->janelas_thrashing, s->janelas,
+                   s->primeira_janela_thrashing);
+        else
+            printf("✅ Sem thrashing (%d janelas de %d ticks)\n", s->janelas, JANELA_THRASHING);
+    }
+
+    long ticks = s->tick;
+    free(s);
+    return ticks;
+}
+
+/**
+ * @brief Modo multiprocesso: relatório detalhado + varredura do grau de multiprogramação.
+ */
+void simular_modo_multiprocesso(ConfigMulti cfg) {
+    Processo modelos[MAX_PROCS];
+
+    printf("============================================================\n");
+    printf("   SIMULAÇÃO MULTIPROCESSO COM POOL DE QUADROS COMPARTILHADO\n");
+    printf("============================================================\n");
+    printf("Processos: %d | Quadros: %d | Refs/processo: %d | Quantum: %d\n",
+           cfg.num_procs, cfg.num_frames, cfg.refs_por_proc, cfg.quantum);
+    printf("Latência do disco: %d ticks | TAU (WS): %d | Limiar PFF: %d\n",
+           cfg.latencia_disco, cfg.tau, cfg.pff_limiar);
+
+    for (int i = 0; i < MAX_PROCS; i++)
+        gerar_traco(&modelos[i], cfg.refs_por_proc, 4 + (i * 7) % 29, 1000u + (unsigned int) i);
+
+    for (int pol = 0; pol < NUM_POLITICAS; pol++)
+        executar_politica(&cfg, modelos, (Politica) pol, true);
+
+    // Grau de multiprogramação crescente: onde cada política entra em thrashing
+    printf("\n------------------------------------------------------------\n");
+    printf("Vazão (refs/1000 ticks) por grau de multiprogramação:\n");
+    printf("Procs |");
+    for (int pol = 0; pol < NUM_POLITICAS; pol++)
+        printf(" %12s |", NOMES_POLITICA[pol]);
+    printf("\n");
+    for (int n = 2; n <= 2 * cfg.num_procs && n <= MAX_PROCS; n += 2) {
+        ConfigMulti c = cfg;
+        c.num_procs = n;
+        printf("%5d |", n);
+        for (int pol = 0; pol < NUM_POLITICAS; pol++) {
+            long ticks = executar_politica(&c, modelos, (Politica) pol, false);
+            printf(" %12.1f |", 1000.0 * n * c.refs_por_proc / ticks);
+        }
+        printf("\n");
+    }
+    printf("------------------------------------------------------------\n");
+
+    for (int i = 0; i < MAX_PROCS; i++) {
+        free(modelos[i].refs);
+        free(modelos[i].page_to_frame);
+    }
+}
+
+// =============================================================
+// PREFETCH — readahead no caminho da falta de página
+// =============================================================
+//
+//  Nos simuladores acima cada falta carrega exatamente uma página.
+//  Aqui o motor LRU chama um prefetcher plugável a cada falta (e ao
+//  tocar uma página "marcadora", como o PG_readahead do Linux), que
+//  sugere páginas extras para ler junto.
+//
+//  Modelo de E/S: cada requisição custa LATENCIA_REQ + TRANSFERENCIA_PAG
+//  por página; páginas contíguas à falta seguem na mesma requisição.
+//  A "espera" conta só a E/S síncrona (a requisição da falta); o
+//  readahead assíncrono ocupa o disco mas não bloqueia o processo.
+// =============================================================
+
+#define LATENCIA_REQ 100          // custo fixo por requisição ao disco
+#define TRANSFERENCIA_PAG 4       // custo por página transferida
+#define MAX_PREFETCH 64           // páginas sugeridas por chamada
+#define JANELA_FIXA 8             // readahead de janela fixa
+#define RA_INICIAL 4              // janela inicial do readahead adaptativo
+#define RA_MAXIMO 32              // janela máxima (read_ahead_kb / 4 KB), limitada a quadros / 4
+#define STRIDE_GRAU 4             // páginas à frente no detector de stride
+
+typedef struct Prefetcher Prefetcher;
+
+/**
+ * @brief Interface de um prefetcher.
+ *
+ * sugerir() recebe a página que causou o evento; 'assincrono' indica
+ * toque em página marcadora (sem falta). Devolve quantas páginas foram
+ * escritas em 'saida' e, opcionalmente, uma página marcadora (-1 = nenhuma).
+ */
+struct Prefetcher {
+    const char *nome;
+    void (*reiniciar)(Prefetcher *pf);
+    int (*sugerir)(Prefetcher *pf, int page, bool assincrono, int *saida, int *marcador);
+
+    // Estado interno (cada implementação usa o que precisa)
+    int inicio, tamanho, async_tamanho;   // janela do readahead adaptativo
+    int anterior;                         // última página com falta
+    int stride, confianca, proximo;       // detector de stride
+    int quadros;                          // memória disponível (definida pelo motor)
+};
+
+typedef struct {
+    int page;
+    int timestamp;
+    bool valid;
+    bool prefetched;    // carregada por prefetch e ainda não referenciada
+    bool marcador;      // tocar esta página dispara readahead assíncrono
+} FramePrefetch;
+
+typedef struct {
+    long faltas;
+    long prefetched;
+    long uteis;          // prefetched e referenciadas antes de sair da memória
+    long poluicao;       // prefetched e expulsas sem uso
+    long requisicoes;
+    long tempo_es;       // ocupação total do disco
+    long tempo_espera;   // E/S síncrona (bloqueante)
+} ResultadoPrefetch;
+
+// -------------------------------------------------------------
+// Prefetchers
+// -------------------------------------------------------------
+
+static void reiniciar_prefetcher(Prefetcher *pf) {
+    pf->inicio = pf->tamanho = pf->async_tamanho = 0;
+    pf->anterior = -2;
+    pf->stride = pf->confianca = pf->proximo = 0;
+}
+
+/**
+ * @brief Janela fixa: a cada falta, lê as JANELA_FIXA páginas seguintes.
+ */
+static int sugerir_janela_fixa(Prefetcher *pf, int page, bool assincrono, int *saida, int *marcador) {
+    (void) pf;
+    (void) assincrono;
+    *marcador = -1;
+    for (int i = 0; i < JANELA_FIXA; i++)
+        saida[i] = page + 1 + i;
+    return JANELA_FIXA;
+}
+
+/**
+ * @brief Readahead adaptativo no estilo do Linux (mm/readahead.c).
+ *
+ * Falta isolada → lê só a página. Falta sequencial → abre uma janela de
+ * RA_INICIAL páginas com marcador logo na segunda. Tocar o marcador lança a
+ * próxima janela de forma assíncrona, dobrando o tamanho até RA_MAXIMO.
+ * Duas janelas ficam em voo ao mesmo tempo; com mais de quadros / 4 cada,
+ * a janela nova expulsa a anterior antes do uso (readahead thrashing).
+ */
+static int sugerir_readahead(Prefetcher *pf, int page, bool assincrono, int *saida, int *marcador) {
+    int n = 0;
+    int maximo = pf->quadros / 4 < RA_MAXIMO ? pf->quadros / 4 : RA_MAXIMO;
+    *marcador = -1;
+
+    if (assincrono) {
+        // Marcador tocado: o fluxo alcançou a janela, avança e cresce
+        pf->inicio += pf->tamanho;
+        pf->tamanho = pf->tamanho * 2 < maximo ? pf->tamanho * 2 : maximo;
+        if (pf->tamanho < 1)
+            pf->tamanho = 1;
+        pf->async_tamanho = pf->tamanho;
+        for (int i = 0; i < pf->tamanho; i++)
+            saida[n++] = pf->inicio + i;
+        *marcador = pf->inicio + pf->tamanho - pf->async_tamanho;
+        return n;
+    }
+
+    bool sequencial = page == pf->anterior + 1 || (pf->tamanho > 0 && page == pf->inicio + pf->tamanho);
+    pf->anterior = page;
+    if (!sequencial) {
+        pf->tamanho = 0;      // leitura aleatória: não polui o estado
+        return 0;
+    }
+
+    pf->inicio = page;
+    pf->tamanho = RA_INICIAL;
+    pf->async_tamanho = RA_INICIAL - 1;
+    for (int i = 1; i < pf->tamanho; i++)
+        saida[n++] = page + i;
+    *marcador = pf->inicio + pf->tamanho - pf->async_tamanho;
+    return n;
+}
+
+/**
+ * @brief Detector de stride: duas faltas com o mesmo passo confirmam o padrão.
+ */
+static int sugerir_stride(Prefetcher *pf, int page, bool assincrono, int *saida, int *marcador) {
+    int n = 0;
+    *marcador = -1;
+
+    if (!assincrono) {
+        int passo = page - pf->anterior;
+        pf->confianca = (passo == pf->stride && passo != 0) ? pf->confianca + 1 : 0;
+        pf->stride = passo;
+        pf->anterior = page;
+        if (pf->confianca < 1)
+            return 0;
+        pf->proximo = page + pf->stride;
+    }
+
+    // Lote de STRIDE_GRAU páginas; o primeiro vira marcador para manter o fluxo à frente
+    for (int i = 0; i < STRIDE_GRAU; i++)
+        saida[n++] = pf->proximo + i * pf->stride;
+    *marcador = saida[0];
+    pf->proximo += STRIDE_GRAU * pf->stride;
+    return n;
+}
+
+// -------------------------------------------------------------
+// Motor LRU com prefetch
+// -------------------------------------------------------------
+
+typedef struct {
+    FramePrefetch *frames;
+    int num_frames;
+    int *page_to_frame;
+    int num_pages;
+    int time;
+    ResultadoPrefetch r;
+} MotorPrefetch;
+
+static int carregar_pagina(MotorPrefetch *m, int page, bool prefetch) {
+    int idx = -1, min_time = __INT_MAX__;
+    for (int j = 0; j < m->num_frames; j++) {
+        if (!m->frames[j].valid) { idx = j; break; }
+        if (m->frames[j].timestamp < min_time) {
+            min_time = m->frames[j].timestamp;
+            idx = j;
+        }
+    }
+
+    FramePrefetch *f = &m->frames[idx];
+    if (f->valid) {
+        m->page_to_frame[f->page] = -1;
+        if (f->prefetched)
+            m->r.poluicao++;
+    }
+    f->page = page;
+    // Antecipada entra como recente (o uso a recarimba): na ponta fria do LRU cada
+    // página antecipada seria a próxima vítima do lote seguinte, ainda sem uso
+    f->timestamp = m->time;
+    f->valid = true;
+    f->prefetched = prefetch;
+    f->marcador = false;
+    m->page_to_frame[page] = idx;
+    return idx;
+}
+
+/**
+ * @brief Lê as páginas sugeridas que ainda não estão na memória.
+ * @param sincrono recebe o custo das páginas que seguem na requisição da falta
+ * @return custo de E/S do lote (requisições contíguas agrupadas)
+ */
+static long executar_prefetch(MotorPrefetch *m, int page_falta, const int *sugeridas, int n, int marcador,
+                              long *sincrono) {
+    long custo = 0;
+    int anterior = page_falta;   // -1 quando não há falta (readahead assíncrono)
+    bool na_falta = page_falta >= 0;
+
+    // Nunca mais que metade da memória num lote: o prefetch não pode expulsar a própria falta
+    if (n > m->num_frames / 2)
+        n = m->num_frames / 2;
+
+    for (int i = 0; i < n; i++) {
+        int p = sugeridas[i];
+        if (p < 0 || p >= m->num_pages || m->page_to_frame[p] >= 0)
+            continue;   // fora do "arquivo" ou já residente
+        carregar_pagina(m, p, true);
+        m->r.prefetched++;
+        if (p != anterior + 1 || anterior < 0) {
+            custo += LATENCIA_REQ;
+            m->r.requisicoes++;
+            na_falta = false;
+        }
+        custo += TRANSFERENCIA_PAG;
+        if (na_falta)
+            *sincrono += TRANSFERENCIA_PAG;
+        anterior = p;
+    }
+
+    if (marcador >= 0 && marcador < m->num_pages && m->page_to_frame[marcador] >= 0)
+        m->frames[m->page_to_frame[marcador]].marcador = true;
+    return custo;
+}
+
+ResultadoPrefetch simulate_LRU_prefetch(const int *refs, int num_refs, int num_frames, Prefetcher *pf) {
+    MotorPrefetch m;
+    int sugeridas[MAX_PREFETCH], marcador;
+
+    memset(&m, 0, sizeof(m));
+    m.num_frames = num_frames;
+    for (int i = 0; i < num_refs; i++)
+        if (refs[i] + 1 > m.num_pages) m.num_pages = refs[i] + 1;
+
+    m.frames = (FramePrefetch *) calloc(num_frames, sizeof(FramePrefetch));
+    m.page_to_frame = (int *) malloc(sizeof(int) * m.num_pages);
+    if (!m.frames || !m.page_to_frame) {
+        perror("Falha ao alocar motor de prefetch");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < m.num_pages; i++)
+        m.page_to_frame[i] = -1;
+    if (pf) {
+        pf->quadros = num_frames;
+        pf->reiniciar(pf);
+    }
+
+    for (int i = 0; i < num_refs; i++) {
+        int page = refs[i];
+        int idx = m.page_to_frame[page];
+        m.time++;
+
+        if (idx >= 0) {
+            FramePrefetch *f = &m.frames[idx];
+            f->timestamp = m.time;
+            if (f->prefetched) {
+                f->prefetched = false;
+                m.r.uteis++;
+            }
+            if (f->marcador && pf) {
+                // Readahead assíncrono: ocupa o disco, não bloqueia
+                f->marcador = false;
+                long sincrono = 0;
+                int n = pf->sugerir(pf, page, true, sugeridas, &marcador);
+                m.r.tempo_es += executar_prefetch(&m, -1, sugeridas, n, marcador, &sincrono);
+            }
+            continue;
+        }
+
+        // Falta: a página pedida e as sugeridas contíguas vão na mesma requisição
+        m.r.faltas++;
+        m.r.requisicoes++;
+        carregar_pagina(&m, page, false);
+        long sincrono = LATENCIA_REQ + TRANSFERENCIA_PAG;
+        long extra = 0;
+        if (pf) {
+            int n = pf->sugerir(pf, page, false, sugeridas, &marcador);
+            extra = executar_prefetch(&m, page, sugeridas, n, marcador, &sincrono);
+        }
+        // A falta espera a própria requisição (com as páginas contíguas); o resto é assíncrono
+        m.r.tempo_espera += sincrono;
+        m.r.tempo_es += LATENCIA_REQ + TRANSFERENCIA_PAG + extra;
+    }
+
+    free(m.frames);
+    free(m.page_to_frame);
+    return m.r;
+}
+
+// -------------------------------------------------------------
+// Traços de teste e relatório
+// -------------------------------------------------------------
+
+typedef struct {
+    const char *nome;
+    int *refs;
+    int num_refs;
+} TracoPrefetch;
+
+/**
+ * @brief Gera os traços sintéticos usados na comparação de prefetchers.
+ */
+static int gerar_tracos_prefetch(TracoPrefetch *tracos, int num_refs) {
+    unsigned int estado = 2024;
+    const char *nomes[] = {"Sequencial (streaming)", "Stride 3", "Aleatório", "Misto (2 fluxos + quentes)",
+                           "Laço maior que a memória"};
+    int n = sizeof(nomes) / sizeof(nomes[0]);
+
+    for (int t = 0; t < n; t++) {
+        int *r = (int *) malloc(sizeof(int) * num_refs);
+        if (!r) {
+            perror("Falha ao alocar traço");
+            exit(EXIT_FAILURE);
+        }
+        int fluxo_a = 0, fluxo_b = 50000;
+        for (int i = 0; i < num_refs; i++) {
+            switch (t) {
+                case 0: r[i] = i / 4; break;                                   // 4 acessos por página
+                case 1: r[i] = (i / 2) * 3; break;                             // salta 2 de cada 3 páginas
+                case 2: r[i] = (int) (rng_multi(&estado) % 8192); break;
+                case 3: {
+                    unsigned int sorteio = rng_multi(&estado) % 10;
+                    if (sorteio < 3) r[i] = 100000 + (int) (rng_multi(&estado) % 16);   // conjunto quente
+                    else if (sorteio < 7) r[i] = fluxo_a++ / 2;
+                    else r[i] = fluxo_b++ / 2;
+                    break;
+                }
+                default: r[i] = i % 300; break;                                // 300 páginas em laço
+            }
+        }
+        tracos[t].nome = nomes[t];
+        tracos[t].refs = r;
+        tracos[t].num_refs = num_refs;
+    }
+    return n;
+}
+
+void imprimir_resultado_prefetch(const char *nome, const ResultadoPrefetch *r, const ResultadoPrefetch *base) {
+    printf("%-20s | %7ld | %+7.1f%% | %7ld | %6.1f%% | %8ld | %9ld | %9ld | %+7.1f%%\n", nome, r->faltas,
+           base->faltas ? 100.0 * (r->faltas - base->faltas) / base->faltas : 0.0, r->prefetched,
+           r->prefetched ? 100.0 * r->uteis / r->prefetched : 0.0, r->poluicao, r->tempo_es, r->tempo_espera,
+           base->tempo_espera ? 100.0 * (r->tempo_espera - base->tempo_espera) / base->tempo_espera : 0.0);
+}
+
+/**
+ * @brief Compara os prefetchers sobre uma lista de traços.
+ */
+void comparar_prefetchers(TracoPrefetch *tracos, int num_tracos, int num_frames) {
+    Prefetcher prefetchers[] = {
+        {"Janela fixa (8)", reiniciar_prefetcher, sugerir_janela_fixa, 0, 0, 0, 0, 0, 0, 0, 0},
+        {"Readahead adaptativo", reiniciar_prefetcher, sugerir_readahead, 0, 0, 0, 0, 0, 0, 0, 0},
+        {"Stride", reiniciar_prefetcher, sugerir_stride, 0, 0, 0, 0, 0, 0, 0, 0},
+    };
+    int num_prefetchers = sizeof(prefetchers) / sizeof(prefetchers[0]);
+
+    printf("Quadros: %d | Custo por requisição: %d | Custo por página: %d\n", num_frames, LATENCIA_REQ,
+           TRANSFERENCIA_PAG);
+
+    for (int t = 0; t < num_tracos; t++) {
+        ResultadoPrefetch base = simulate_LRU_prefetch(tracos[t].refs, tracos[t].num_refs, num_frames, NULL);
+
+        printf("\n🔹 Traço: %s (%d referências)\n", tracos[t].nome, tracos[t].num_refs);
+        printf("-------------------------------------------------------------------------------------------------\n");
+        printf("%-20s | %7s | %8s | %7s | %7s | %8s | %9s | %9s | %8s\n", "Prefetcher", "Faltas", "Δ faltas",
+               "Prefet.", "Úteis", "Poluição", "E/S total", "Espera", "Δ espera");
+        imprimir_resultado_prefetch("Nenhum (LRU puro)", &base, &base);
+        for (int p = 0; p < num_prefetchers; p++) {
+            ResultadoPrefetch r = simulate_LRU_prefetch(tracos[t].refs, tracos[t].num_refs, num_frames,
+                                                        &prefetchers[p]);
+            imprimir_resultado_prefetch(prefetchers[p].nome, &r, &base);
+        }
+    }
+    printf("-------------------------------------------------------------------------------------------------\n");
+    printf("Úteis: %% das páginas lidas antecipadamente que foram usadas antes de sair da memória.\n");
+    printf("Poluição: páginas antecipadas expulsas sem uso (ocuparam quadros de páginas úteis).\n");
+}
+
+void simular_modo_prefetch(int num_frames) {
+    TracoPrefetch tracos[8];
+
+    printf("============================================================\n");
+    printf("   PREFETCH NA FALTA DE PÁGINA (LRU + READAHEAD)\n");
+    printf("============================================================\n");
+
+    int n = gerar_tracos_prefetch(tracos, 40000);
+    comparar_prefetchers(tracos, n, num_frames);
+    for (int t = 0; t < n; t++)
+        free(tracos[t].refs);
+}
+
+// =============================================================
+// TRAÇOS EXTERNOS (.pgt)
+// -------------------------------------------------------------
+// Reproduz um traço gravado por trace/trace_tool no motor de
+// prefetch. Os endereços viram páginas (>> bits_pagina) e as
+// páginas são compactadas: vizinhas continuam vizinhas (o
+// readahead depende disso), mas lacunas entre regiões encolhem
+// para LACUNA_MAX páginas, então um espaço de 48 bits cabe num
+// vetor page_to_frame pequeno.
+// =============================================================
+
+#define LACUNA_MAX (MAX_PREFETCH + 1)
+#define MAX_REFS_TRACO 4000000
+
+static int comparar_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *) a, y = *(const uint64_t *) b;
+    return x < y ? -1 : x > y;
+}
+
+/**
+ * @brief Lê até 'max_refs' referências a partir de 'inicio' e devolve páginas compactadas.
+ * @return vetor alocado (NULL em caso de erro); num_paginas recebe as páginas distintas
+ */
+int *carregar_traco_paginas(const char *caminho, int bits_pagina, long max_refs, long inicio, int *num_refs,
+                            int *num_paginas) {
+    LeitorTraco *l = traco_abrir(caminho);
+    if (!l) return NULL;
+    if ((uint64_t) inicio >= traco_total(l) || !traco_posicionar(l, (uint64_t) inicio)) {
+        fprintf(stderr, "[ERRO] Início %ld além do fim do traço (%llu referências)\n", inicio,
+                (unsigned long long) traco_total(l));
+        traco_fechar(l);
+        return NULL;
+    }
+
+    uint64_t restantes = traco_total(l) - (uint64_t) inicio;
+    int n = (int) (restantes < (uint64_t) max_refs ? restantes : (uint64_t) max_refs);
+    uint64_t *paginas = (uint64_t *) malloc(sizeof(uint64_t) * n);
+    uint64_t *unicas = (uint64_t *) malloc(sizeof(uint64_t) * n);
+    int *ids = (int *) malloc(sizeof(int) * n);
+    int *refs = (int *) malloc(sizeof(int) * n);
+    if (!paginas || !unicas || !ids || !refs) {
+        perror("Falha ao alocar traço");
+        exit(EXIT_FAILURE);
+    }
+    n = (int) traco_ler(l, paginas, (size_t) n);
+    traco_fechar(l);
+
+    for (int i = 0; i < n; i++)
+        unicas[i] = paginas[i] >>= bits_pagina;
+    qsort(unicas, n, sizeof(uint64_t), comparar_u64);
+
+    int distintas = 0, proximo_id = 0;
+    for (int i = 0; i < n; i++) {
+        if (distintas && unicas[i] == unicas[distintas - 1]) continue;
+        if (distintas) {
+            uint64_t salto = unicas[i] - unicas[distintas - 1];
+            proximo_id += salto < LACUNA_MAX ? (int) salto : LACUNA_MAX;
+        }
+        unicas[distintas] = unicas[i];
+        ids[distintas++] = proximo_id;
+    }
+    for (int i = 0; i < n; i++) {
+        const uint64_t *achada = (const uint64_t *) bsearch(&paginas[i], unicas, distintas, sizeof(uint64_t),
+                                                            comparar_u64);
+        refs[i] = ids[achada - unicas];
+    }
+
+    free(paginas);
+    free(unicas);
+    free(ids);
+    *num_refs = n;
+    *num_paginas = distintas;
+    return refs;
+}
+
+bool simular_modo_traco(const char *caminho, int num_frames, int bits_pagina, long max_refs, long inicio) {
+    TracoPrefetch traco;
+    int num_paginas;
+
+    traco.refs = carregar_traco_paginas(caminho, bits_pagina, max_refs, inicio, &traco.num_refs, &num_paginas);
+    if (!traco.refs) return false;
+    traco.nome = caminho;
+
+    printf("============================================================\n");
+    printf("   TRAÇO EXTERNO: %s\n", caminho);
+    printf("============================================================\n");
+    printf("Referências %ld a %ld | %d páginas distintas de %d bytes | decodificador %s\n", inicio,
+           inicio + traco.num_refs - 1, num_paginas, 1 << bits_pagina, traco_nome_decodificador());
+
+    comparar_prefetchers(&traco, 1, num_frames);
+    free(traco.refs);
+    return true;
+}
+
 // =============================================================
 // MAIN
 // =============================================================
 
-int main(void) {
+int main(int argc, char **argv) {
+    // Modo multiprocesso: ./page_replacement --multi [processos] [quadros]
+    if (argc > 1 && strcmp(argv[1], "--multi") == 0) {
+        ConfigMulti cfg = {8, 96, 50000, 50, 100, 400, 300};
+        if (argc > 2) cfg.num_procs = atoi(argv[2]);
+        if (argc > 3) cfg.num_frames = atoi(argv[3]);
+        if (cfg.num_procs < 1 || cfg.num_procs > MAX_PROCS / 2 || cfg.num_frames < cfg.num_procs) {
+            fprintf(stderr, "Uso: %s --multi [processos (1-%d)] [quadros (>= processos)]\n", argv[0], MAX_PROCS / 2);
+            return 1;
+        }
+        simular_modo_multiprocesso(cfg);
+        return 0;
+    }
+
+    // Modo prefetch: ./page_replacement --prefetch [quadros]
+    if (argc > 1 && strcmp(argv[1], "--prefetch") == 0) {
+        int quadros = argc > 2 ? atoi(argv[2]) : 64;
+        if (quadros < 2) {
+            fprintf(stderr, "Uso: %s --prefetch [quadros (>= 2)]\n", argv[0]);
+            return 1;
+        }
+        simular_modo_prefetch(quadros);
+        return 0;
+    }
+
+    // Traço gravado: ./page_replacement --traco arquivo.pgt [quadros] [bits_pagina] [max_refs] [inicio]
+    if (argc > 2 && strcmp(argv[1], "--traco") == 0) {
+        int quadros = argc > 3 ? atoi(argv[3]) : 64;
+        int bits = argc > 4 ? atoi(argv[4]) : 12;
+        long max_refs = argc > 5 ? atol(argv[5]) : MAX_REFS_TRACO;
+        long inicio = argc > 6 ? atol(argv[6]) : 0;
+        if (quadros < 2 || bits < 0 || bits > 30 || max_refs < 1 || max_refs > MAX_REFS_TRACO || inicio < 0) {
+            fprintf(stderr, "Uso: %s --traco arquivo.pgt [quadros (>= 2)] [bits_pagina (0-30)] [max_refs (<= %d)] "
+                    "[inicio]\n", argv[0], MAX_REFS_TRACO);
+            return 1;
+        }
+        return simular_modo_traco(argv[2], quadros, bits, max_refs, inicio) ? 0 : 1;
+    }
+
     int refs[] = {7, 0, 1, 2, 0, 3, 0, 4, 2, 3, 0, 3};
     int num_refs = sizeof(refs) / sizeof(refs[0]);
     int num_frames = 3;
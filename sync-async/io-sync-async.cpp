@@ -0,0 +1,632 @@
+/**
+ * ============================================================
+ *  MODELOS DE E/S: SÍNCRONO x THREAD-POR-REQUISIÇÃO x ASSÍNCRONO
+ *  ------------------------------------------------------------
+ *  Versão em C++20 do experimento de sync-async/io-sync-async.py
+ *  Autor: Gabriel Rozendo
+ * ============================================================
+ *
+ *  O script em Python simula E/S com sleeps. Aqui cada requisição
+ *  faz E/S de verdade:
+ *   1. Lê um bloco de 4 KB de um arquivo local (pread / io_uring).
+ *   2. Envia uma mensagem por um pipe a um "dispositivo" (thread
+ *      com epoll + timerfd) que responde após um atraso fixo,
+ *      simulando a latência de um disco ou serviço remoto.
+ *   3. Aguarda a resposta por outro pipe.
+ *
+ *  Modelos comparados:
+ *   • Síncrono           → uma requisição por vez, chamadas bloqueantes.
+ *   • Thread/requisição  → uma std::thread nova por requisição,
+ *                          até N requisições simultâneas.
+ *   • Assíncrono         → uma única thread com corrotinas C++20;
+ *                          pipes aguardados via epoll e leituras de
+ *                          arquivo submetidas ao io_uring.
+ *
+ *  Para cada nível de concorrência o programa mede a vazão
+ *  (requisições/s) e a distribuição de latência (p50/p99/p99.9).
+ *  O modelo é de carga fechada: cada "cliente" só emite uma nova
+ *  requisição quando a anterior termina.
+ *
+ *  Compilação (Linux ≥ 5.6):
+ *    g++ -std=c++20 -O2 -pthread sync-async/io-sync-async.cpp -o sync-async/io_sync_async
+ * ============================================================
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <semaphore>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+// =============================================================
+// Parâmetros do experimento
+// =============================================================
+
+constexpr size_t TAMANHO_BLOCO = 4096;
+constexpr size_t TAMANHO_ARQUIVO = 16u << 20;          // 16 MB de dados reais
+constexpr const char *ARQUIVO_DADOS = "io_sync_async.dat";
+constexpr int NIVEIS_CONCORRENCIA[] = {1, 4, 16, 64, 256};
+
+// Mensagem trocada com o dispositivo (menor que PIPE_BUF → escrita atômica)
+struct Mensagem {
+    uint64_t id;
+    uint64_t checksum;
+};
+
+// Par de pipes de um cliente: req (cliente → dispositivo), resp (dispositivo → cliente)
+struct Canal {
+    int req[2];
+    int resp[2];
+};
+
+inline uint64_t agora_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+[[noreturn]] void falhar(const char *msg) {
+    perror(msg);
+    exit(EXIT_FAILURE);
+}
+
+void definir_nao_bloqueante(int fd, bool ativo) {
+    int flags = fcntl(fd, F_GETFL);
+    fcntl(fd, F_SETFL, ativo ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK));
+}
+
+// Offset pseudoaleatório (mas determinístico) do bloco lido pela requisição
+inline off_t offset_do_bloco(uint64_t id) {
+    uint64_t x = id * 0x9E3779B97F4A7C15ull;
+    return (off_t)((x >> 32) % (TAMANHO_ARQUIVO / TAMANHO_BLOCO)) * TAMANHO_BLOCO;
+}
+
+inline uint64_t soma_bloco(const unsigned char *bloco) {
+    uint64_t s = 0;
+    for (size_t i = 0; i < TAMANHO_BLOCO; i += 64)
+        s += bloco[i];
+    return s;
+}
+
+// =============================================================
+// Dispositivo simulado — responde cada mensagem após um atraso
+// =============================================================
+
+class Dispositivo {
+public:
+    Dispositivo(std::vector<Canal> &canais, uint64_t atraso_ns)
+        : canais_(canais), atraso_ns_(atraso_ns) {
+        epfd_ = epoll_create1(0);
+        timerfd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+        parar_fd_ = eventfd(0, EFD_NONBLOCK);
+        if (epfd_ < 0 || timerfd_ < 0 || parar_fd_ < 0)
+            falhar("dispositivo");
+
+        registrar(timerfd_, -1);
+        registrar(parar_fd_, -2);
+        for (size_t i = 0; i < canais_.size(); i++) {
+            definir_nao_bloqueante(canais_[i].req[0], true);
+            registrar(canais_[i].req[0], (int)i);
+        }
+        thread_ = std::thread([this] { executar(); });
+    }
+
+    ~Dispositivo() {
+        uint64_t um = 1;
+        if (write(parar_fd_, &um, sizeof(um)) < 0)
+            perror("eventfd");
+        thread_.join();
+        close(epfd_);
+        close(timerfd_);
+        close(parar_fd_);
+    }
+
+private:
+    struct Pendente {
+        uint64_t prazo;
+        int canal;
+        Mensagem msg;
+        bool operator>(const Pendente &o) const { return prazo > o.prazo; }
+    };
+
+    void registrar(int fd, int tag) {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = (uint64_t)(int64_t)tag;
+        if (epoll_ctl(epfd_, EPOLL_CTL_ADD, fd, &ev) < 0)
+            falhar("epoll_ctl (dispositivo)");
+    }
+
+    // Programa o timerfd para o prazo da próxima resposta
+    void armar_timer() {
+        itimerspec t{};
+        if (!fila_.empty()) {
+            t.it_value.tv_sec = (time_t)(fila_.top().prazo / 1000000000ull);
+            t.it_value.tv_nsec = (long)(fila_.top().prazo % 1000000000ull);
+        }
+        timerfd_settime(timerfd_, TFD_TIMER_ABSTIME, &t, nullptr);
+    }
+
+    void executar() {
+        epoll_event eventos[64];
+        for (;;) {
+            int n = epoll_wait(epfd_, eventos, 64, -1);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                falhar("epoll_wait (dispositivo)");
+            }
+            bool rearmar = false;
+
+            for (int i = 0; i < n; i++) {
+                int tag = (int)(int64_t)eventos[i].data.u64;
+                if (tag == -2)
+                    return;
+                if (tag == -1) {
+                    uint64_t expiracoes;
+                    if (read(timerfd_, &expiracoes, sizeof(expiracoes)) < 0 && errno != EAGAIN)
+                        perror("timerfd");
+                    continue;
+                }
+                Mensagem msg;
+                while (read(canais_[tag].req[0], &msg, sizeof(msg)) == (ssize_t)sizeof(msg)) {
+                    fila_.push({agora_ns() + atraso_ns_, tag, msg});
+                    rearmar = true;
+                }
+            }
+
+            // Entrega tudo que já venceu (cada canal tem no máximo uma resposta no pipe)
+            uint64_t t = agora_ns();
+            while (!fila_.empty() && fila_.top().prazo <= t) {
+                Pendente p = fila_.top();
+                fila_.pop();
+                if (write(canais_[p.canal].resp[1], &p.msg, sizeof(p.msg)) != (ssize_t)sizeof(p.msg))
+                    falhar("write (dispositivo)");
+                rearmar = true;
+            }
+            if (rearmar)
+                armar_timer();
+        }
+    }
+
+    std::vector<Canal> &canais_;
+    uint64_t atraso_ns_;
+    int epfd_, timerfd_, parar_fd_;
+    std::priority_queue<Pendente, std::vector<Pendente>, std::greater<Pendente>> fila_;
+    std::thread thread_;
+};
+
+// =============================================================
+// Requisição bloqueante (modelos síncrono e thread/requisição)
+// =============================================================
+
+void requisicao_bloqueante(int arquivo, const Canal &canal, uint64_t id) {
+    alignas(64) unsigned char bloco[TAMANHO_BLOCO];
+    if (pread(arquivo, bloco, TAMANHO_BLOCO, offset_do_bloco(id)) != (ssize_t)TAMANHO_BLOCO)
+        falhar("pread");
+
+    Mensagem msg{id, soma_bloco(bloco)};
+    if (write(canal.req[1], &msg, sizeof(msg)) != (ssize_t)sizeof(msg))
+        falhar("write");
+    if (read(canal.resp[0], &msg, sizeof(msg)) != (ssize_t)sizeof(msg))
+        falhar("read");
+}
+
+void executar_sincrono(int arquivo, std::vector<Canal> &canais, std::vector<uint64_t> &latencias) {
+    for (uint64_t id = 0; id < latencias.size(); id++) {
+        uint64_t inicio = agora_ns();
+        requisicao_bloqueante(arquivo, canais[0], id);
+        latencias[id] = agora_ns() - inicio;
+    }
+}
+
+void executar_thread_por_requisicao(int arquivo, std::vector<Canal> &canais, int concorrencia,
+                                    std::vector<uint64_t> &latencias) {
+    // Threads destacadas ainda podem estar dentro de release() quando a última vaga
+    // volta: o estado compartilhado vive até a última delas terminar.
+    struct Vagas {
+        std::counting_semaphore<> semaforo;
+        std::mutex trava;
+        std::vector<int> livres;
+        explicit Vagas(int n) : semaforo(n) {}
+    };
+    auto vagas = std::make_shared<Vagas>(concorrencia);
+    for (int i = concorrencia - 1; i >= 0; i--)
+        vagas->livres.push_back(i);
+
+    for (uint64_t id = 0; id < latencias.size(); id++) {
+        vagas->semaforo.acquire();
+        int slot;
+        {
+            std::lock_guard<std::mutex> g(vagas->trava);
+            slot = vagas->livres.back();
+            vagas->livres.pop_back();
+        }
+        uint64_t inicio = agora_ns();
+        Canal *canal = &canais[slot];
+        uint64_t *latencia = &latencias[id];
+        std::thread([vagas, arquivo, canal, latencia, slot, id, inicio] {
+            requisicao_bloqueante(arquivo, *canal, id);
+            *latencia = agora_ns() - inicio;
+            {
+                std::lock_guard<std::mutex> g(vagas->trava);
+                vagas->livres.push_back(slot);
+            }
+            vagas->semaforo.release();
+        }).detach();
+    }
+
+    // Espera as últimas threads devolverem suas vagas
+    for (int i = 0; i < concorrencia; i++)
+        vagas->semaforo.acquire();
+}
+
+// =============================================================
+// Reator assíncrono — epoll para pipes, io_uring para arquivos
+// =============================================================
+
+class Reator {
+public:
+    // Operação de arquivo em andamento no io_uring
+    struct OperacaoArquivo {
+        std::coroutine_handle<> h;
+        int resultado;
+    };
+
+    explicit Reator(unsigned entradas) {
+        epfd_ = epoll_create1(0);
+        if (epfd_ < 0)
+            falhar("epoll_create1");
+        iniciar_uring(entradas);
+    }
+
+    ~Reator() {
+        if (uring_fd_ >= 0) {
+            munmap(sq_ptr_, sq_tamanho_);
+            if (cq_ptr_ != sq_ptr_)
+                munmap(cq_ptr_, cq_tamanho_);
+            munmap(sqes_, sqes_tamanho_);
+            close(uring_fd_);
+        }
+        close(epfd_);
+    }
+
+    bool uring_ativo() const { return uring_fd_ >= 0; }
+
+    // Suspende a corrotina até o fd ficar pronto (EPOLLONESHOT: um despertar por espera)
+    void aguardar_fd(int fd, uint32_t eventos, std::coroutine_handle<> h) {
+        epoll_event ev{};
+        ev.events = eventos | EPOLLONESHOT;
+        ev.data.ptr = h.address();
+        if ((size_t)fd >= registrado_.size())
+            registrado_.resize(fd + 1, 0);
+        int op = registrado_[fd] ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+        if (epoll_ctl(epfd_, op, fd, &ev) < 0)
+            falhar("epoll_ctl");
+        registrado_[fd] = 1;
+    }
+
+    // Coloca uma leitura na fila de submissão; enviada em lote no próximo ciclo
+    void enviar_leitura(int fd, void *buf, unsigned tamanho, off_t offset, OperacaoArquivo *op) {
+        if (pendentes_ == sq_entradas_)
+            submeter();
+        unsigned cauda = *sq_tail_;
+        unsigned idx = cauda & *sq_mask_;
+        io_uring_sqe *sqe = &sqes_[idx];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = fd;
+        sqe->addr = (uint64_t)(uintptr_t)buf;
+        sqe->len = tamanho;
+        sqe->off = (uint64_t)offset;
+        sqe->user_data = (uint64_t)(uintptr_t)op;
+        sq_array_[idx] = idx;
+        __atomic_store_n(sq_tail_, cauda + 1, __ATOMIC_RELEASE);
+        pendentes_++;
+    }
+
+    // Um ciclo do laço de eventos: submete, espera e retoma as corrotinas prontas
+    void executar_uma_vez() {
+        submeter();
+        epoll_event eventos[256];
+        int n = epoll_wait(epfd_, eventos, 256, -1);
+        if (n < 0) {
+            if (errno == EINTR)
+                return;
+            falhar("epoll_wait");
+        }
+        for (int i = 0; i < n; i++) {
+            if (eventos[i].data.ptr == nullptr)
+                colher_conclusoes();
+            else
+                std::coroutine_handle<>::from_address(eventos[i].data.ptr).resume();
+        }
+    }
+
+private:
+    void iniciar_uring(unsigned entradas) {
+        io_uring_params p{};
+        uring_fd_ = (int)syscall(__NR_io_uring_setup, entradas, &p);
+        if (uring_fd_ < 0)
+            return;   // kernel sem io_uring → leituras de arquivo síncronas
+
+        sq_tamanho_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_tamanho_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        if (p.features & IORING_FEAT_SINGLE_MMAP)
+            sq_tamanho_ = cq_tamanho_ = std::max(sq_tamanho_, cq_tamanho_);
+
+        sq_ptr_ = (unsigned char *)mmap(nullptr, sq_tamanho_, PROT_READ | PROT_WRITE,
+                                        MAP_SHARED | MAP_POPULATE, uring_fd_, IORING_OFF_SQ_RING);
+        cq_ptr_ = (p.features & IORING_FEAT_SINGLE_MMAP)
+                      ? sq_ptr_
+                      : (unsigned char *)mmap(nullptr, cq_tamanho_, PROT_READ | PROT_WRITE,
+                                              MAP_SHARED | MAP_POPULATE, uring_fd_, IORING_OFF_CQ_RING);
+        sqes_tamanho_ = p.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = (io_uring_sqe *)mmap(nullptr, sqes_tamanho_, PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_POPULATE, uring_fd_, IORING_OFF_SQES);
+        if (sq_ptr_ == MAP_FAILED || cq_ptr_ == MAP_FAILED || sqes_ == MAP_FAILED)
+            falhar("mmap (io_uring)");
+
+        sq_entradas_ = p.sq_entries;
+        sq_tail_ = (unsigned *)(sq_ptr_ + p.sq_off.tail);
+        sq_mask_ = (unsigned *)(sq_ptr_ + p.sq_off.ring_mask);
+        sq_array_ = (unsigned *)(sq_ptr_ + p.sq_off.array);
+        cq_head_ = (unsigned *)(cq_ptr_ + p.cq_off.head);
+        cq_tail_ = (unsigned *)(cq_ptr_ + p.cq_off.tail);
+        cq_mask_ = (unsigned *)(cq_ptr_ + p.cq_off.ring_mask);
+        cqes_ = (io_uring_cqe *)(cq_ptr_ + p.cq_off.cqes);
+
+        // O fd do io_uring fica legível quando há conclusões: o epoll cobre os dois mundos
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = nullptr;
+        if (epoll_ctl(epfd_, EPOLL_CTL_ADD, uring_fd_, &ev) < 0)
+            falhar("epoll_ctl (io_uring)");
+    }
+
+    void submeter() {
+        if (pendentes_ == 0)
+            return;
+        if (syscall(__NR_io_uring_enter, uring_fd_, pendentes_, 0, 0, nullptr, 0) < 0)
+            falhar("io_uring_enter");
+        pendentes_ = 0;
+    }
+
+    void colher_conclusoes() {
+        unsigned cabeca = *cq_head_;
+        unsigned cauda = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        while (cabeca != cauda) {
+            io_uring_cqe *cqe = &cqes_[cabeca & *cq_mask_];
+            auto *op = (OperacaoArquivo *)(uintptr_t)cqe->user_data;
+            op->resultado = cqe->res;
+            cabeca++;
+            __atomic_store_n(cq_head_, cabeca, __ATOMIC_RELEASE);
+            op->h.resume();
+        }
+    }
+
+    int epfd_;
+    std::vector<uint8_t> registrado_;
+
+    int uring_fd_ = -1;
+    unsigned pendentes_ = 0, sq_entradas_ = 0;
+    size_t sq_tamanho_ = 0, cq_tamanho_ = 0, sqes_tamanho_ = 0;
+    unsigned char *sq_ptr_ = nullptr, *cq_ptr_ = nullptr;
+    io_uring_sqe *sqes_ = nullptr;
+    io_uring_cqe *cqes_ = nullptr;
+    unsigned *sq_tail_ = nullptr, *sq_mask_ = nullptr, *sq_array_ = nullptr;
+    unsigned *cq_head_ = nullptr, *cq_tail_ = nullptr, *cq_mask_ = nullptr;
+};
+
+// Corrotina "dispara e esquece": começa imediatamente e se destrói ao terminar
+struct Tarefa {
+    struct promise_type {
+        Tarefa get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// co_await ler_arquivo(...) → pread via io_uring (ou direto, se indisponível)
+struct LerArquivo {
+    Reator &reator;
+    int fd;
+    void *buf;
+    unsigned tamanho;
+    off_t offset;
+    Reator::OperacaoArquivo op{};
+
+    bool await_ready() {
+        if (reator.uring_ativo())
+            return false;
+        op.resultado = (int)pread(fd, buf, tamanho, offset);
+        return true;
+    }
+    void await_suspend(std::coroutine_handle<> h) {
+        op.h = h;
+        reator.enviar_leitura(fd, buf, tamanho, offset, &op);
+    }
+    int await_resume() const { return op.resultado; }
+};
+
+// co_await esperar_fd(...) → suspende até o pipe ficar legível/gravável
+struct EsperarFd {
+    Reator &reator;
+    int fd;
+    uint32_t eventos;
+
+    bool await_ready() const { return false; }
+    void await_suspend(std::coroutine_handle<> h) { reator.aguardar_fd(fd, eventos, h); }
+    void await_resume() const {}
+};
+
+Tarefa cliente_assincrono(Reator &reator, int arquivo, const Canal &canal, uint64_t primeiro,
+                          uint64_t passo, std::vector<uint64_t> &latencias, int &ativos) {
+    alignas(64) unsigned char bloco[TAMANHO_BLOCO];
+
+    for (uint64_t id = primeiro; id < latencias.size(); id += passo) {
+        uint64_t inicio = agora_ns();
+
+        int lidos = co_await LerArquivo{reator, arquivo, bloco, (unsigned)TAMANHO_BLOCO, offset_do_bloco(id)};
+        if (lidos != (int)TAMANHO_BLOCO)
+            falhar("leitura assíncrona");
+
+        Mensagem msg{id, soma_bloco(bloco)};
+        while (write(canal.req[1], &msg, sizeof(msg)) < 0) {
+            if (errno != EAGAIN)
+                falhar("write");
+            co_await EsperarFd{reator, canal.req[1], EPOLLOUT};
+        }
+        while (read(canal.resp[0], &msg, sizeof(msg)) < 0) {
+            if (errno != EAGAIN)
+                falhar("read");
+            co_await EsperarFd{reator, canal.resp[0], EPOLLIN};
+        }
+
+        latencias[id] = agora_ns() - inicio;
+    }
+    ativos--;
+}
+
+void executar_assincrono(Reator &reator, int arquivo, std::vector<Canal> &canais, int concorrencia,
+                         std::vector<uint64_t> &latencias) {
+    for (int i = 0; i < concorrencia; i++) {
+        definir_nao_bloqueante(canais[i].req[1], true);
+        definir_nao_bloqueante(canais[i].resp[0], true);
+    }
+
+    int ativos = concorrencia;
+    for (int i = 0; i < concorrencia; i++)
+        cliente_assincrono(reator, arquivo, canais[i], (uint64_t)i, (uint64_t)concorrencia, latencias, ativos);
+    while (ativos > 0)
+        reator.executar_uma_vez();
+
+    for (int i = 0; i < concorrencia; i++) {
+        definir_nao_bloqueante(canais[i].req[1], false);
+        definir_nao_bloqueante(canais[i].resp[0], false);
+    }
+}
+
+// =============================================================
+// Relatório
+// =============================================================
+
+void imprimir_linha(const char *modelo, int concorrencia, double segundos, std::vector<uint64_t> &latencias) {
+    std::sort(latencias.begin(), latencias.end());
+    auto percentil = [&](double p) {
+        size_t i = (size_t)(p * (double)(latencias.size() - 1));
+        return (double)latencias[i] / 1000.0;
+    };
+    printf("%-18s | %5d | %12.0f | %9.1f | %9.1f | %9.1f | %9.1f\n", modelo, concorrencia,
+           (double)latencias.size() / segundos, percentil(0.50), percentil(0.99), percentil(0.999),
+           (double)latencias.back() / 1000.0);
+}
+
+template <typename Func>
+void medir(const char *modelo, int concorrencia, size_t requisicoes, Func executar) {
+    std::vector<uint64_t> latencias(requisicoes);
+    uint64_t inicio = agora_ns();
+    executar(latencias);
+    double segundos = (double)(agora_ns() - inicio) / 1e9;
+    imprimir_linha(modelo, concorrencia, segundos, latencias);
+}
+
+int main(int argc, char **argv) {
+    size_t requisicoes = argc > 1 ? strtoul(argv[1], nullptr, 10) : 5000;
+    uint64_t atraso_us = argc > 2 ? strtoull(argv[2], nullptr, 10) : 200;
+    int max_concorrencia = argc > 3 ? atoi(argv[3]) : 256;
+    if (requisicoes == 0 || max_concorrencia <= 0) {
+        fprintf(stderr, "Uso: %s [requisicoes] [atraso_us] [max_concorrencia]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Cada cliente usa 4 descritores (dois pipes)
+    rlimit lim{};
+    getrlimit(RLIMIT_NOFILE, &lim);
+    lim.rlim_cur = lim.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &lim);
+
+    // Arquivo de dados real (fica no page cache após a primeira passada)
+    int arquivo = open(ARQUIVO_DADOS, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (arquivo < 0)
+        falhar("open");
+    std::vector<unsigned char> conteudo(TAMANHO_ARQUIVO);
+    for (size_t i = 0; i < conteudo.size(); i++)
+        conteudo[i] = (unsigned char)(i * 31 + 7);
+    if (write(arquivo, conteudo.data(), conteudo.size()) != (ssize_t)conteudo.size())
+        falhar("write (arquivo de dados)");
+
+    std::vector<Canal> canais(max_concorrencia);
+    for (Canal &c : canais)
+        if (pipe(c.req) < 0 || pipe(c.resp) < 0)
+            falhar("pipe");
+
+    Reator reator((unsigned)std::max(256, max_concorrencia));
+
+    printf("============================================================\n");
+    printf("   MODELOS DE E/S: SÍNCRONO x THREADS x ASSÍNCRONO (C++20)\n");
+    printf("============================================================\n");
+    printf("Requisições por execução : %zu\n", requisicoes);
+    printf("Atraso do dispositivo    : %llu us\n", (unsigned long long)atraso_us);
+    printf("Leitura de arquivo       : %s\n", reator.uring_ativo() ? "io_uring (IORING_OP_READ)" : "pread síncrono");
+    printf("Espera em pipes          : epoll (EPOLLONESHOT)\n\n");
+
+    printf("%-18s | %5s | %12s | %9s | %9s | %9s | %9s\n", "Modelo", "Conc.", "Vazao (r/s)",
+           "p50 (us)", "p99 (us)", "p99.9 (us)", "max (us)");
+    printf("-------------------+-------+--------------+-----------+-----------+-----------+----------\n");
+
+    {
+        Dispositivo dispositivo(canais, atraso_us * 1000);
+
+        medir("Sincrono", 1, requisicoes, [&](std::vector<uint64_t> &lat) {
+            executar_sincrono(arquivo, canais, lat);
+        });
+
+        for (int concorrencia : NIVEIS_CONCORRENCIA) {
+            if (concorrencia > max_concorrencia)
+                break;
+            medir("Thread/requisicao", concorrencia, requisicoes, [&](std::vector<uint64_t> &lat) {
+                executar_thread_por_requisicao(arquivo, canais, concorrencia, lat);
+            });
+            medir("Assincrono", concorrencia, requisicoes, [&](std::vector<uint64_t> &lat) {
+                executar_assincrono(reator, arquivo, canais, concorrencia, lat);
+            });
+        }
+    }
+
+    printf("\nObservação:\n");
+    printf("- Síncrono: vazão limitada a ~1/latência; nada se sobrepõe.\n");
+    printf("- Threads: sobrepõem a espera, mas pagam criação de thread e trocas de contexto.\n");
+    printf("- Assíncrono: uma thread só; o custo por requisição é o de uma corrotina.\n");
+
+    for (Canal &c : canais) {
+        close(c.req[0]);
+        close(c.req[1]);
+        close(c.resp[0]);
+        close(c.resp[1]);
+    }
+    close(arquivo);
+    unlink(ARQUIVO_DADOS);
+    return EXIT_SUCCESS;
+}
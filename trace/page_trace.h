@@ -0,0 +1,688 @@
+/**
+ * ============================================================
+ *  Formato Comprimido de Traços de Endereços (.pgt)
+ *  Autor: Gabriel Rozendo
+ *  Capítulo: 17 – Paginação em Disco
+ * ============================================================
+ *  Objetivo:
+ *  - Guardar traços de referências à memória (endereços de 64
+ *    bits) numa fração do tamanho do arquivo bruto e permitir
+ *    que page_replacement e mmu_simulator os reproduzam.
+ *  - Biblioteca em um único cabeçalho: basta incluir
+ *    "../trace/page_trace.h" no simulador.
+ * ============================================================
+ *  Layout do arquivo (little-endian):
+ *
+ *    [CabecalhoTraco][bloco 0][bloco 1]...[bloco N-1][índice]
+ *
+ *  - Cada bloco tem até refs_por_bloco referências. O índice no
+ *    fim do arquivo guarda, por bloco, o offset, o primeiro
+ *    endereço (base) e o modo de codificação; como todos os
+ *    blocos exceto o último estão cheios, a referência i fica no
+ *    bloco i / refs_por_bloco e o posicionamento é direto.
+ *  - Modo SVB (padrão): cada referência vai para um de até 4
+ *    canais — o de último endereço mais próximo —, de modo que
+ *    código, heap e pilha intercalados viram fluxos separados
+ *    com deltas pequenos. Em cada canal: delta do endereço
+ *    anterior → zigzag → Stream VByte. O Stream VByte é um varint
+ *    cujos comprimentos (1 a 4 bytes, 2 bits cada) ficam num
+ *    fluxo de controle separado dos dados: um byte de controle
+ *    descreve 4 valores e vira uma máscara de pshufb, então 4
+ *    deltas são extraídos de uma vez, sem o laço serial byte a
+ *    byte do varint LEB128. Um fluxo de 2 bits por referência
+ *    (omitido com um só canal) guarda a ordem original.
+ *
+ *      [CabecalhoBloco][canais (2 bits/ref)][canal 0]...[canal 3]
+ *      canal = [controle (2 bits/ref)][deltas (1 a 4 bytes)]
+ *
+ *  - Modo BRUTO: blocos com algum salto maior que ±2^31 dentro
+ *    de um canal, ou que não ficariam menores, são gravados como
+ *    uint64_t sem compressão.
+ * ============================================================
+ *  Decodificação:
+ *  - SSE4.1 (pshufb + soma de prefixo em 64 bits) escolhida em
+ *    tempo de execução via CPUID; caminho escalar equivalente
+ *    nas demais CPUs. traco_forcar_escalar() permite comparar.
+ * ============================================================
+ */
+
+#ifndef PAGE_TRACE_H
+#define PAGE_TRACE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define TRACO_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TRACO_ALVO_SSE41
+#else
+#define TRACO_ALVO_SSE41 __attribute__((target("sse4.1")))
+#endif
+#else
+#define TRACO_X86 0
+#endif
+
+#if defined(_WIN32)
+#define TRACO_FSEEK _fseeki64
+#define TRACO_FTELL _ftelli64
+#else
+#define TRACO_FSEEK fseeko
+#define TRACO_FTELL ftello
+#endif
+
+// =====================
+// CONSTANTES
+// =====================
+
+#define TRACO_MAGICA "PGTRACE1"
+#define TRACO_VERSAO 1
+#define TRACO_REFS_POR_BLOCO 65536     // 512 KB decodificados por bloco
+#define TRACO_MAX_REFS_POR_BLOCO (1u << 24)
+#define TRACO_FOLGA 16                 // bytes extras: o pshufb lê 16 bytes por grupo
+#define TRACO_CANAIS 4
+#define TRACO_DIST_NOVO_CANAL 65536    // salto que abre um canal novo (se houver livre)
+
+#define TRACO_MODO_SVB 0
+#define TRACO_MODO_BRUTO 1
+
+// =====================
+// ESTRUTURAS EM DISCO
+// =====================
+
+typedef struct {
+    char magica[8];
+    uint32_t versao;
+    uint32_t refs_por_bloco;
+    uint64_t total_refs;
+    uint64_t num_blocos;
+    uint64_t offset_indice;
+} CabecalhoTraco;                      // 40 bytes
+
+typedef struct {
+    uint64_t offset;                   // posição do bloco no arquivo
+    uint64_t base;                     // primeiro endereço do bloco
+    uint32_t bytes;                    // tamanho codificado
+    uint32_t quantidade;               // referências no bloco
+    uint32_t modo;                     // TRACO_MODO_SVB ou TRACO_MODO_BRUTO
+    uint32_t reservado;
+} EntradaIndice;                       // 32 bytes
+
+typedef struct {
+    uint64_t base[TRACO_CANAIS];       // primeiro endereço de cada canal
+    uint32_t quantidade[TRACO_CANAIS]; // referências por canal
+    uint32_t bytes[TRACO_CANAIS];      // controle + deltas de cada canal
+    uint32_t num_canais;
+    uint32_t reservado;
+} CabecalhoBloco;                      // 72 bytes, no início de cada bloco SVB
+
+// =====================
+// TABELAS DO STREAM VBYTE
+// =====================
+
+static uint8_t traco_mascaras_svb[256][16];   // controle → máscara de pshufb
+static uint8_t traco_comprimentos_svb[256];   // controle → bytes consumidos
+static int traco_decodificador = -1;          // -1 = não escolhido, 0 = escalar, 1 = SSE4.1
+
+static inline void traco_iniciar_tabelas(void) {
+    static bool prontas = false;
+    if (prontas) return;
+    for (int c = 0; c < 256; c++) {
+        int pos = 0;
+        for (int v = 0; v < 4; v++) {
+            int len = ((c >> (2 * v)) & 3) + 1;
+            for (int b = 0; b < 4; b++)
+                traco_mascaras_svb[c][4 * v + b] = (uint8_t) (b < len ? pos + b : 0x80);   // 0x80 zera o byte
+            pos += len;
+        }
+        traco_comprimentos_svb[c] = (uint8_t) pos;
+    }
+    prontas = true;
+}
+
+static inline bool traco_simd_disponivel(void) {
+#if TRACO_X86 && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] >> 19) & 1;
+#elif TRACO_X86
+    return __builtin_cpu_supports("sse4.1");
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Força o decodificador escalar (true) ou volta à detecção automática (false).
+ */
+static inline void traco_forcar_escalar(bool escalar) {
+    traco_decodificador = escalar ? 0 : -1;
+}
+
+static inline const char *traco_nome_decodificador(void) {
+    if (traco_decodificador < 0)
+        traco_decodificador = traco_simd_disponivel() ? 1 : 0;
+    return traco_decodificador ? "SSE4.1" : "escalar";
+}
+
+// =====================
+// CODIFICAÇÃO
+// =====================
+
+static inline uint64_t traco_zigzag(int64_t d) {
+    return ((uint64_t) d << 1) ^ (uint64_t) (d >> 63);
+}
+
+/**
+ * @brief Stream VByte de um canal: controle seguido dos deltas zigzag.
+ * @return bytes gravados
+ */
+static inline uint32_t traco_codificar_svb(const uint32_t *zigzag, uint32_t n, uint8_t *saida) {
+    uint32_t bytes_controle = (n + 3) / 4;
+    uint8_t *dados = saida + bytes_controle;
+    memset(saida, 0, bytes_controle);
+
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t z = zigzag[i];
+        uint32_t len = z < (1u << 8) ? 1 : z < (1u << 16) ? 2 : z < (1u << 24) ? 3 : 4;
+        saida[i / 4] |= (uint8_t) ((len - 1) << (2 * (i % 4)));
+        for (uint32_t b = 0; b < len; b++)
+            *dados++ = (uint8_t) (z >> (8 * b));
+    }
+    return (uint32_t) (dados - saida);
+}
+
+/**
+ * @brief Codifica um bloco; cai para BRUTO se algum delta não cabe em 32 bits.
+ * @param saida buffer com pelo menos 8 * n + 128 bytes
+ * @param temporario buffer com pelo menos 4 * n bytes
+ * @return bytes gravados em 'saida'
+ */
+static inline uint32_t traco_codificar_bloco(const uint64_t *refs, uint32_t n, uint8_t *saida, uint32_t *temporario,
+                                             uint32_t *modo) {
+    CabecalhoBloco cab;
+    uint64_t ultimo[TRACO_CANAIS];
+    memset(&cab, 0, sizeof(cab));
+
+    // 1ª passada: escolhe o canal de cada referência e conta
+    uint8_t *canais = saida + sizeof(CabecalhoBloco);
+    memset(canais, 0, (n + 3) / 4);
+    bool cabe = true;
+    for (uint32_t i = 0; i < n && cabe; i++) {
+        uint32_t c = 0;
+        uint64_t menor = UINT64_MAX;
+        for (uint32_t k = 0; k < cab.num_canais; k++) {
+            uint64_t dist = refs[i] > ultimo[k] ? refs[i] - ultimo[k] : ultimo[k] - refs[i];
+            if (dist < menor) {
+                menor = dist;
+                c = k;
+            }
+        }
+        if (cab.num_canais < TRACO_CANAIS && (cab.num_canais == 0 || menor > TRACO_DIST_NOVO_CANAL)) {
+            c = cab.num_canais++;
+            cab.base[c] = ultimo[c] = refs[i];
+        }
+        cabe = traco_zigzag((int64_t) (refs[i] - ultimo[c])) <= 0xFFFFFFFFu;
+        ultimo[c] = refs[i];
+        cab.quantidade[c]++;
+        canais[i / 4] |= (uint8_t) (c << (2 * (i % 4)));
+    }
+
+    uint32_t total = sizeof(CabecalhoBloco) + (cab.num_canais > 1 ? (n + 3) / 4 : 0);
+    if (cabe) {
+        // 2ª passada: deltas agrupados por canal, cada grupo codificado em sequência
+        uint32_t inicio[TRACO_CANAIS], pos[TRACO_CANAIS];
+        for (uint32_t c = 0, acumulado = 0; c < cab.num_canais; c++) {
+            inicio[c] = pos[c] = acumulado;
+            acumulado += cab.quantidade[c];
+            ultimo[c] = cab.base[c];
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            uint32_t c = cab.num_canais > 1 ? (canais[i / 4] >> (2 * (i % 4))) & 3 : 0;
+            temporario[pos[c]++] = (uint32_t) traco_zigzag((int64_t) (refs[i] - ultimo[c]));
+            ultimo[c] = refs[i];
+        }
+        for (uint32_t c = 0; c < cab.num_canais; c++) {
+            cab.bytes[c] = traco_codificar_svb(temporario + inicio[c], cab.quantidade[c], saida + total);
+            total += cab.bytes[c];
+        }
+    }
+
+    if (!cabe || total >= sizeof(uint64_t) * n) {
+        *modo = TRACO_MODO_BRUTO;
+        memcpy(saida, refs, sizeof(uint64_t) * n);
+        return (uint32_t) (sizeof(uint64_t) * n);
+    }
+    memcpy(saida, &cab, sizeof(CabecalhoBloco));
+    *modo = TRACO_MODO_SVB;
+    return total;
+}
+
+// =====================
+// DECODIFICAÇÃO
+// =====================
+
+/**
+ * @brief Decodifica os valores [inicio, n) de um bloco SVB; 'dados' aponta para o valor 'inicio'.
+ */
+static inline void traco_decodificar_svb_escalar(const uint8_t *controle, const uint8_t *dados, uint32_t inicio,
+                                                 uint32_t n, uint64_t base, uint64_t *saida) {
+    for (uint32_t i = inicio; i < n; i++) {
+        uint32_t len = ((controle[i / 4] >> (2 * (i % 4))) & 3) + 1;
+        uint32_t z = 0;
+        for (uint32_t b = 0; b < len; b++)
+            z |= (uint32_t) dados[b] << (8 * b);
+        dados += len;
+        base += (uint64_t) (int64_t) (int32_t) ((z >> 1) ^ (0u - (z & 1)));
+        saida[i] = base;
+    }
+}
+
+#if TRACO_X86
+/**
+ * @brief Decodifica 'grupos' grupos de 4 valores: pshufb → zigzag → soma de prefixo.
+ * @return ponteiro para os dados do primeiro valor não decodificado
+ */
+TRACO_ALVO_SSE41 static inline const uint8_t *traco_decodificar_svb_sse41(const uint8_t *controle,
+                                                                          const uint8_t *dados, uint32_t grupos,
+                                                                          uint64_t *base, uint64_t *saida) {
+    const __m128i um = _mm_set1_epi32(1);
+    __m128i acumulado = _mm_set1_epi64x((long long) *base);
+
+    for (uint32_t g = 0; g < grupos; g++) {
+        uint8_t c = controle[g];
+        __m128i v = _mm_loadu_si128((const __m128i *) dados);
+        v = _mm_shuffle_epi8(v, _mm_loadu_si128((const __m128i *) traco_mascaras_svb[c]));
+        dados += traco_comprimentos_svb[c];
+
+        // zigzag: (z >> 1) ^ -(z & 1), em 4 lanes de 32 bits
+        __m128i d = _mm_xor_si128(_mm_srli_epi32(v, 1), _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(v, um)));
+
+        // Estende para 64 bits e soma prefixos: [d0, d0+d1] e [d2, d2+d3]
+        __m128i baixo = _mm_cvtepi32_epi64(d);
+        __m128i alto = _mm_cvtepi32_epi64(_mm_srli_si128(d, 8));
+        baixo = _mm_add_epi64(baixo, _mm_slli_si128(baixo, 8));
+        alto = _mm_add_epi64(alto, _mm_slli_si128(alto, 8));
+
+        baixo = _mm_add_epi64(baixo, acumulado);
+        acumulado = _mm_unpackhi_epi64(baixo, baixo);
+        alto = _mm_add_epi64(alto, acumulado);
+        acumulado = _mm_unpackhi_epi64(alto, alto);
+
+        _mm_storeu_si128((__m128i *) (saida + 4 * g), baixo);
+        _mm_storeu_si128((__m128i *) (saida + 4 * g + 2), alto);
+    }
+    _mm_storel_epi64((__m128i *) base, acumulado);
+    return dados;
+}
+#endif
+
+/**
+ * @brief Decodifica um canal SVB inteiro (controle + deltas) a partir de 'base'.
+ */
+static inline void traco_decodificar_svb(const uint8_t *dados, uint32_t n, uint64_t base, uint64_t *saida) {
+    const uint8_t *controle = dados;
+    const uint8_t *valores = dados + (n + 3) / 4;
+    uint32_t inicio = 0;
+
+    traco_nome_decodificador();
+#if TRACO_X86
+    if (traco_decodificador == 1) {
+        traco_iniciar_tabelas();
+        inicio = n / 4 * 4;
+        valores = traco_decodificar_svb_sse41(controle, valores, n / 4, &base, saida);
+    }
+#endif
+    traco_decodificar_svb_escalar(controle, valores, inicio, n, base, saida);
+}
+
+/**
+ * @brief Decodifica um bloco inteiro.
+ * @param dados bloco codificado, seguido de TRACO_FOLGA bytes legíveis
+ * @param temporario buffer com e->quantidade posições (usado com mais de um canal)
+ */
+static inline void traco_decodificar_bloco(const EntradaIndice *e, const uint8_t *dados, uint64_t *saida,
+                                           uint64_t *temporario) {
+    if (e->modo == TRACO_MODO_BRUTO) {
+        memcpy(saida, dados, sizeof(uint64_t) * e->quantidade);
+        return;
+    }
+
+    CabecalhoBloco cab;
+    memcpy(&cab, dados, sizeof(CabecalhoBloco));
+    uint32_t n = e->quantidade;
+    const uint8_t *canais = dados + sizeof(CabecalhoBloco);
+
+    if (cab.num_canais == 1) {
+        traco_decodificar_svb(canais, n, cab.base[0], saida);
+        return;
+    }
+
+    // Cada canal é decodificado em sua faixa do temporário e depois intercalado pela ordem original
+    const uint8_t *p = canais + (n + 3) / 4;
+    const uint64_t *fontes[TRACO_CANAIS];
+    uint64_t *destino = temporario;
+    for (uint32_t c = 0; c < cab.num_canais; c++) {
+        traco_decodificar_svb(p, cab.quantidade[c], cab.base[c], destino);
+        fontes[c] = destino;
+        destino += cab.quantidade[c];
+        p += cab.bytes[c];
+    }
+    for (uint32_t i = 0; i < n; i++)
+        saida[i] = *fontes[(canais[i / 4] >> (2 * (i % 4))) & 3]++;
+}
+
+static inline void traco_histograma(const uint8_t *p, uint64_t n, uint64_t histograma[256]) {
+    memset(histograma, 0, sizeof(uint64_t) * 256);
+    for (uint64_t i = 0; i < n; i++)
+        histograma[p[i]]++;
+}
+
+/**
+ * @brief Confere um bloco SVB inteiro antes de decodificá-lo.
+ *
+ * O decodificador confia no bloco: um canal inexistente no fluxo intercalado
+ * acessaria fontes[] não inicializadas, contagens divergentes esgotariam um canal
+ * e comprimentos de controle maiores que os bytes do canal fariam o pshufb ler
+ * além da folga. Por isso tudo isso é conferido aqui.
+ */
+static inline bool traco_bloco_valido(const EntradaIndice *e, const uint8_t *dados) {
+    if (e->modo == TRACO_MODO_BRUTO) return e->bytes == sizeof(uint64_t) * e->quantidade;
+    if (e->modo != TRACO_MODO_SVB || e->bytes < sizeof(CabecalhoBloco)) return false;
+
+    CabecalhoBloco cab;
+    memcpy(&cab, dados, sizeof(CabecalhoBloco));
+    if (cab.num_canais < 1 || cab.num_canais > TRACO_CANAIS) return false;
+    uint64_t n = e->quantidade;
+    uint64_t refs = 0, bytes = sizeof(CabecalhoBloco) + (cab.num_canais > 1 ? (n + 3) / 4 : 0);
+    for (uint32_t c = 0; c < cab.num_canais; c++) {
+        refs += cab.quantidade[c];
+        bytes += cab.bytes[c];
+    }
+    if (refs != n || bytes != e->bytes) return false;
+
+    // Os dois fluxos de 2 bits (canais e controle) são conferidos por histograma de
+    // bytes: um incremento por byte em vez de um desvio por referência
+    uint64_t histograma[256];
+    const uint8_t *canais = dados + sizeof(CabecalhoBloco);
+    if (cab.num_canais > 1) {
+        // Fluxo intercalado: só canais existentes, na quantidade declarada, e bits de sobra zerados
+        uint64_t contagem[TRACO_CANAIS] = {0, 0, 0, 0};
+        traco_histograma(canais, n / 4, histograma);
+        for (uint32_t v = 0; v < 256; v++) {
+            if (!histograma[v]) continue;
+            for (uint32_t k = 0; k < 4; k++) {
+                uint32_t c = (v >> (2 * k)) & 3;
+                if (c >= cab.num_canais) return false;
+                contagem[c] += histograma[v];
+            }
+        }
+        for (uint64_t i = n / 4 * 4; i < n; i++) {
+            uint32_t c = (canais[i / 4] >> (2 * (i % 4))) & 3;
+            if (c >= cab.num_canais) return false;
+            contagem[c]++;
+        }
+        if (n % 4 != 0 && (canais[n / 4] >> (2 * (n % 4))) != 0) return false;
+        for (uint32_t c = 0; c < cab.num_canais; c++)
+            if (contagem[c] != cab.quantidade[c]) return false;
+    }
+
+    // Cada canal: bytes de controle + comprimentos declarados neles = bytes do canal
+    // (senão o pshufb do último grupo lê além da folga)
+    traco_iniciar_tabelas();
+    const uint8_t *p = canais + (cab.num_canais > 1 ? (n + 3) / 4 : 0);
+    for (uint32_t c = 0; c < cab.num_canais; c++) {
+        uint64_t q = cab.quantidade[c], total = (q + 3) / 4;
+        if (total > cab.bytes[c]) return false;
+        traco_histograma(p, q / 4, histograma);
+        for (uint32_t v = 0; v < 256; v++)
+            total += histograma[v] * traco_comprimentos_svb[v];
+        for (uint64_t i = q / 4 * 4; i < q; i++)
+            total += ((p[i / 4] >> (2 * (i % 4))) & 3) + 1;
+        if (total != cab.bytes[c]) return false;
+        p += cab.bytes[c];
+    }
+    return true;
+}
+
+// =====================
+// ESCRITA
+// =====================
+
+typedef struct {
+    FILE *arquivo;
+    CabecalhoTraco cab;
+    uint64_t *pendentes;
+    uint32_t num_pendentes;
+    uint8_t *codificado;
+    uint32_t *temporario;
+    EntradaIndice *indice;
+    uint64_t capacidade_indice;
+    uint64_t offset;
+} EscritorTraco;
+
+static inline void traco_liberar_escritor(EscritorTraco *w) {
+    if (w->arquivo) fclose(w->arquivo);
+    free(w->pendentes);
+    free(w->codificado);
+    free(w->temporario);
+    free(w->indice);
+    free(w);
+}
+
+/**
+ * @brief Cria um arquivo de traço vazio.
+ * @param refs_por_bloco 0 = TRACO_REFS_POR_BLOCO
+ * @return NULL em caso de erro (errno preservado)
+ */
+static inline EscritorTraco *traco_criar(const char *caminho, uint32_t refs_por_bloco) {
+    if (refs_por_bloco == 0) refs_por_bloco = TRACO_REFS_POR_BLOCO;
+    if (refs_por_bloco > TRACO_MAX_REFS_POR_BLOCO) refs_por_bloco = TRACO_MAX_REFS_POR_BLOCO;
+
+    EscritorTraco *w = (EscritorTraco *) calloc(1, sizeof(EscritorTraco));
+    if (!w) return NULL;
+    memcpy(w->cab.magica, TRACO_MAGICA, 8);
+    w->cab.versao = TRACO_VERSAO;
+    w->cab.refs_por_bloco = refs_por_bloco;
+    w->offset = sizeof(CabecalhoTraco);
+
+    w->pendentes = (uint64_t *) malloc(sizeof(uint64_t) * refs_por_bloco);
+    w->codificado = (uint8_t *) malloc(sizeof(uint64_t) * refs_por_bloco + 128);
+    w->temporario = (uint32_t *) malloc(sizeof(uint32_t) * refs_por_bloco);
+    w->arquivo = fopen(caminho, "wb");
+    if (!w->pendentes || !w->codificado || !w->temporario || !w->arquivo ||
+        fwrite(&w->cab, sizeof(CabecalhoTraco), 1, w->arquivo) != 1) {
+        traco_liberar_escritor(w);
+        return NULL;
+    }
+    return w;
+}
+
+static inline bool traco_gravar_bloco(EscritorTraco *w) {
+    if (w->num_pendentes == 0) return true;
+
+    if (w->cab.num_blocos == w->capacidade_indice) {
+        uint64_t nova = w->capacidade_indice ? w->capacidade_indice * 2 : 64;
+        EntradaIndice *indice = (EntradaIndice *) realloc(w->indice, sizeof(EntradaIndice) * nova);
+        if (!indice) return false;
+        w->indice = indice;
+        w->capacidade_indice = nova;
+    }
+
+    EntradaIndice *e = &w->indice[w->cab.num_blocos];
+    memset(e, 0, sizeof(EntradaIndice));
+    e->offset = w->offset;
+    e->base = w->pendentes[0];
+    e->quantidade = w->num_pendentes;
+    e->bytes = traco_codificar_bloco(w->pendentes, w->num_pendentes, w->codificado, w->temporario, &e->modo);
+    if (fwrite(w->codificado, 1, e->bytes, w->arquivo) != e->bytes)
+        return false;
+
+    w->offset += e->bytes;
+    w->cab.total_refs += w->num_pendentes;
+    w->cab.num_blocos++;
+    w->num_pendentes = 0;
+    return true;
+}
+
+static inline bool traco_escrever(EscritorTraco *w, uint64_t endereco) {
+    w->pendentes[w->num_pendentes++] = endereco;
+    if (w->num_pendentes == w->cab.refs_por_bloco)
+        return traco_gravar_bloco(w);
+    return true;
+}
+
+/**
+ * @brief Grava o último bloco, o índice e o cabecalho definitivo; libera o escritor.
+ */
+static inline bool traco_fechar_escrita(EscritorTraco *w) {
+    bool ok = traco_gravar_bloco(w);
+    w->cab.offset_indice = w->offset;
+    if (ok && w->cab.num_blocos)
+        ok = fwrite(w->indice, sizeof(EntradaIndice), w->cab.num_blocos, w->arquivo) == w->cab.num_blocos;
+    ok = ok && TRACO_FSEEK(w->arquivo, 0, SEEK_SET) == 0 &&
+         fwrite(&w->cab, sizeof(CabecalhoTraco), 1, w->arquivo) == 1;
+    ok = fclose(w->arquivo) == 0 && ok;
+    w->arquivo = NULL;
+    traco_liberar_escritor(w);
+    return ok;
+}
+
+// =====================
+// LEITURA
+// =====================
+
+typedef struct {
+    FILE *arquivo;
+    CabecalhoTraco cab;
+    EntradaIndice *indice;
+    uint8_t *comprimido;              // bloco lido do disco (+ TRACO_FOLGA)
+    uint64_t *bloco;                  // bloco decodificado
+    uint64_t *temporario;             // canais antes da intercalação
+    uint64_t bloco_atual;             // UINT64_MAX = nenhum
+    uint32_t posicao;                 // próxima referência dentro do bloco
+} LeitorTraco;
+
+static inline void traco_fechar(LeitorTraco *l) {
+    if (!l) return;
+    if (l->arquivo) fclose(l->arquivo);
+    free(l->indice);
+    free(l->comprimido);
+    free(l->bloco);
+    free(l->temporario);
+    free(l);
+}
+
+/**
+ * @brief Abre um traço e carrega o índice de blocos.
+ * @return NULL (com a causa em stderr) se o arquivo não existe ou não é um traço válido
+ */
+static inline LeitorTraco *traco_abrir(const char *caminho) {
+    LeitorTraco *l = (LeitorTraco *) calloc(1, sizeof(LeitorTraco));
+    if (!l) return NULL;
+    l->bloco_atual = UINT64_MAX;
+
+    l->arquivo = fopen(caminho, "rb");
+    if (!l->arquivo) {
+        fprintf(stderr, "[ERRO] %s: %s\n", caminho, strerror(errno));
+        traco_fechar(l);
+        return NULL;
+    }
+
+    CabecalhoTraco *c = &l->cab;
+    if (fread(c, sizeof(CabecalhoTraco), 1, l->arquivo) != 1 || memcmp(c->magica, TRACO_MAGICA, 8) != 0 ||
+        c->versao != TRACO_VERSAO || c->refs_por_bloco == 0 || c->refs_por_bloco > TRACO_MAX_REFS_POR_BLOCO ||
+        c->num_blocos != (c->total_refs + c->refs_por_bloco - 1) / c->refs_por_bloco) {
+        fprintf(stderr, "[ERRO] %s não é um traço .pgt válido (versão %d)\n", caminho, TRACO_VERSAO);
+        traco_fechar(l);
+        return NULL;
+    }
+
+    l->indice = (EntradaIndice *) malloc(sizeof(EntradaIndice) * (c->num_blocos ? c->num_blocos : 1));
+    l->comprimido = (uint8_t *) malloc(sizeof(uint64_t) * c->refs_por_bloco + TRACO_FOLGA);
+    l->bloco = (uint64_t *) malloc(sizeof(uint64_t) * c->refs_por_bloco);
+    l->temporario = (uint64_t *) malloc(sizeof(uint64_t) * c->refs_por_bloco);
+    if (!l->indice || !l->comprimido || !l->bloco || !l->temporario || TRACO_FSEEK(l->arquivo, (long long) c->offset_indice, SEEK_SET) ||
+        fread(l->indice, sizeof(EntradaIndice), c->num_blocos, l->arquivo) != c->num_blocos) {
+        fprintf(stderr, "[ERRO] Índice do traço %s ilegível\n", caminho);
+        traco_fechar(l);
+        return NULL;
+    }
+
+    // Todo bloco tem refs_por_bloco referências, menos o último (o resto): traco_posicionar
+    // e traco_ler calculam a posição dentro do bloco a partir disso
+    for (uint64_t b = 0; b < c->num_blocos; b++) {
+        const EntradaIndice *e = &l->indice[b];
+        uint64_t esperado = b + 1 < c->num_blocos ? c->refs_por_bloco : c->total_refs - b * c->refs_por_bloco;
+        if (e->quantidade != esperado || e->bytes > sizeof(uint64_t) * e->quantidade) {
+            fprintf(stderr, "[ERRO] Bloco %llu do traço %s corrompido\n", (unsigned long long) b, caminho);
+            traco_fechar(l);
+            return NULL;
+        }
+    }
+    memset(l->comprimido, 0, sizeof(uint64_t) * c->refs_por_bloco + TRACO_FOLGA);
+    return l;
+}
+
+static inline uint64_t traco_total(const LeitorTraco *l) {
+    return l->cab.total_refs;
+}
+
+/**
+ * @brief Lê e decodifica o bloco 'b' (se ainda não for o atual).
+ */
+static inline bool traco_carregar_bloco(LeitorTraco *l, uint64_t b) {
+    if (b == l->bloco_atual) return true;
+    if (b >= l->cab.num_blocos) return false;
+
+    const EntradaIndice *e = &l->indice[b];
+    if (TRACO_FSEEK(l->arquivo, (long long) e->offset, SEEK_SET) != 0 ||
+        fread(l->comprimido, 1, e->bytes, l->arquivo) != e->bytes || !traco_bloco_valido(e, l->comprimido))
+        return false;
+    traco_decodificar_bloco(e, l->comprimido, l->bloco, l->temporario);
+    l->bloco_atual = b;
+    return true;
+}
+
+/**
+ * @brief Posiciona o leitor na referência de índice 'ref' (0 = início).
+ */
+static inline bool traco_posicionar(LeitorTraco *l, uint64_t ref) {
+    if (ref >= l->cab.total_refs) return false;
+    if (!traco_carregar_bloco(l, ref / l->cab.refs_por_bloco)) return false;
+    l->posicao = (uint32_t) (ref % l->cab.refs_por_bloco);
+    return true;
+}
+
+/**
+ * @brief Copia até 'max' referências a partir da posição atual.
+ * @return quantidade copiada (0 no fim do traço)
+ */
+static inline size_t traco_ler(LeitorTraco *l, uint64_t *destino, size_t max) {
+    size_t lidas = 0;
+    while (lidas < max) {
+        if (l->bloco_atual == UINT64_MAX || l->posicao == l->indice[l->bloco_atual].quantidade) {
+            uint64_t proximo = l->bloco_atual == UINT64_MAX ? 0 : l->bloco_atual + 1;
+            if (!traco_carregar_bloco(l, proximo)) break;
+            l->posicao = 0;
+        }
+        uint32_t disponiveis = l->indice[l->bloco_atual].quantidade - l->posicao;
+        size_t n = max - lidas < disponiveis ? max - lidas : disponiveis;
+        memcpy(destino + lidas, l->bloco + l->posicao, sizeof(uint64_t) * n);
+        l->posicao += (uint32_t) n;
+        lidas += n;
+    }
+    return lidas;
+}
+
+static inline bool traco_proximo(LeitorTraco *l, uint64_t *endereco) {
+    return traco_ler(l, endereco, 1) == 1;
+}
+
+#endif // PAGE_TRACE_H
@@ -0,0 +1,455 @@
+/**
+ * ============================================================
+ *  Ferramenta de Traços .pgt (conversão, inspeção e benchmark)
+ *  Autor: Gabriel Rozendo
+ *  Capítulo: 17 – Paginação em Disco
+ * ============================================================
+ *  Comandos:
+ *   converter <entrada> <saida.pgt> [--binario] [--hex] [--bloco N]
+ *       Texto: um endereço por linha (decimal ou 0x...; hexadecimal
+ *       sem 0x com --hex). Aceita a saída do Valgrind Lackey
+ *       (" L 04222cac,4"), sempre em hexadecimal; linhas iniciadas
+ *       por '#' ou '=' são ignoradas.
+ *       Binário (--binario): uint64_t little-endian em sequência.
+ *   exportar <traco.pgt> <saida> [--binario]
+ *       Caminho inverso, para conferir a conversão.
+ *   info <traco.pgt>
+ *       Cabeçalho, taxa de compressão e blocos por modo.
+ *   gerar <saida.pgt> [refs] [--bruto arquivo.bin]
+ *       Traço sintético (laços, varreduras, pilha, saltos de heap).
+ *   bench <traco.pgt> [bruto.bin] [--disco MB/s]
+ *       Vazão do decodificador escalar x SSE4.1 e comparação com
+ *       a leitura do arquivo bruto.
+ * ============================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+#include <chrono>
+#include <vector>
+
+#include "page_trace.h"
+
+#define LOTE 65536   // referências por leitura/escrita em lote
+
+static double agora() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static const char *opcao(int argc, char **argv, const char *nome) {
+    for (int i = 0; i < argc - 1; i++)
+        if (strcmp(argv[i], nome) == 0) return argv[i + 1];
+    return NULL;
+}
+
+static bool tem_opcao(int argc, char **argv, const char *nome) {
+    for (int i = 0; i < argc; i++)
+        if (strcmp(argv[i], nome) == 0) return true;
+    return false;
+}
+
+static long long tamanho_arquivo(const char *caminho) {
+    FILE *f = fopen(caminho, "rb");
+    if (!f) return -1;
+    TRACO_FSEEK(f, 0, SEEK_END);
+    long long tam = (long long) TRACO_FTELL(f);
+    fclose(f);
+    return tam;
+}
+
+// =====================
+// CONVERSÃO
+// =====================
+
+/**
+ * @brief Extrai o endereço de uma linha de texto.
+ * @return false para linhas vazias, comentários e cabeçalhos do Valgrind
+ */
+static bool analisar_linha(const char *linha, int base, uint64_t *endereco) {
+    const char *p = linha;
+    while (*p == ' ' || *p == '\t') p++;
+    if (*p == '\0' || *p == '\n' || *p == '\r' || *p == '#' || *p == '=') return false;
+
+    // Formato Lackey: operação (I, L, S, M) seguida de espaço; o endereço é
+    // sempre hexadecimal sem 0x ("04222cac" não é octal nem decimal)
+    if (strchr("ILSM", *p) && (p[1] == ' ' || p[1] == '\t')) {
+        p++;
+        while (*p == ' ' || *p == '\t') p++;
+        base = 16;
+    }
+
+    char *fim;
+    *endereco = strtoull(p, &fim, base);
+    return fim != p;
+}
+
+static int converter(const char *entrada, const char *saida, bool binario, bool hex, uint32_t bloco) {
+    FILE *in = fopen(entrada, binario ? "rb" : "r");
+    if (!in) {
+        perror("Erro ao abrir a entrada");
+        return 1;
+    }
+    EscritorTraco *w = traco_criar(saida, bloco);
+    if (!w) {
+        perror("Erro ao criar o traço");
+        fclose(in);
+        return 1;
+    }
+
+    double inicio = agora();
+    uint64_t total = 0, ignoradas = 0;
+    bool ok = true;
+
+    if (binario) {
+        std::vector<uint64_t> lote(LOTE);
+        size_t n;
+        while (ok && (n = fread(lote.data(), sizeof(uint64_t), LOTE, in)) > 0) {
+            for (size_t i = 0; i < n && ok; i++)
+                ok = traco_escrever(w, lote[i]);
+            total += n;
+        }
+    } else {
+        char linha[512];
+        uint64_t endereco;
+        while (ok && fgets(linha, sizeof(linha), in)) {
+            if (analisar_linha(linha, hex ? 16 : 0, &endereco)) {
+                ok = traco_escrever(w, endereco);
+                total++;
+            } else {
+                ignoradas++;
+            }
+        }
+    }
+    fclose(in);
+
+    if (!traco_fechar_escrita(w) || !ok) {
+        perror("Erro ao gravar o traço");
+        return 1;
+    }
+
+    long long bytes_entrada = tamanho_arquivo(entrada), bytes_saida = tamanho_arquivo(saida);
+    printf("Convertidas %llu referências (%llu linhas ignoradas) em %.2f s\n", (unsigned long long) total,
+           (unsigned long long) ignoradas, agora() - inicio);
+    printf("  %s: %lld bytes → %s: %lld bytes (%.2f bytes/ref, %.1fx menor que uint64_t bruto)\n", entrada,
+           bytes_entrada, saida, bytes_saida, total ? (double) bytes_saida / total : 0.0,
+           bytes_saida > 0 ? 8.0 * total / bytes_saida : 0.0);
+    return 0;
+}
+
+static int exportar(const char *traco, const char *saida, bool binario) {
+    LeitorTraco *l = traco_abrir(traco);
+    if (!l) return 1;
+    FILE *out = fopen(saida, binario ? "wb" : "w");
+    if (!out) {
+        perror("Erro ao criar a saída");
+        traco_fechar(l);
+        return 1;
+    }
+
+    std::vector<uint64_t> lote(LOTE);
+    size_t n;
+    uint64_t exportadas = 0;
+    while ((n = traco_ler(l, lote.data(), LOTE)) > 0) {
+        if (binario)
+            fwrite(lote.data(), sizeof(uint64_t), n, out);
+        else
+            for (size_t i = 0; i < n; i++)
+                fprintf(out, "0x%llx\n", (unsigned long long) lote[i]);
+        exportadas += n;
+    }
+    bool ok = fclose(out) == 0;
+    if (exportadas != traco_total(l)) {
+        // traco_ler para no primeiro bloco ilegível ou corrompido
+        fprintf(stderr, "[ERRO] Bloco corrompido: só %llu de %llu referências exportadas\n",
+                (unsigned long long) exportadas, (unsigned long long) traco_total(l));
+        ok = false;
+    }
+    printf("Exportadas %llu referências para %s\n", (unsigned long long) exportadas, saida);
+    traco_fechar(l);
+    return ok ? 0 : 1;
+}
+
+// =====================
+// INSPEÇÃO
+// =====================
+
+static int info(const char *traco) {
+    LeitorTraco *l = traco_abrir(traco);
+    if (!l) return 1;
+
+    const CabecalhoTraco *c = &l->cab;
+    uint64_t blocos_svb = 0, bytes_svb = 0, refs_svb = 0, bytes_bruto = 0;
+    for (uint64_t b = 0; b < c->num_blocos; b++) {
+        const EntradaIndice *e = &l->indice[b];
+        if (e->modo == TRACO_MODO_SVB) {
+            blocos_svb++;
+            bytes_svb += e->bytes;
+            refs_svb += e->quantidade;
+        } else {
+            bytes_bruto += e->bytes;
+        }
+    }
+    long long tamanho = tamanho_arquivo(traco);
+
+    printf("Traço %s\n", traco);
+    printf("  Referências:        %llu\n", (unsigned long long) c->total_refs);
+    printf("  Blocos:             %llu (%u refs cada) | SVB: %llu | brutos: %llu\n",
+           (unsigned long long) c->num_blocos, c->refs_por_bloco, (unsigned long long) blocos_svb,
+           (unsigned long long) (c->num_blocos - blocos_svb));
+    printf("  Tamanho em disco:   %lld bytes (índice: %llu bytes)\n", tamanho,
+           (unsigned long long) (c->num_blocos * sizeof(EntradaIndice)));
+    printf("  Equivalente bruto:  %llu bytes → %.1fx de compressão\n", (unsigned long long) (c->total_refs * 8),
+           tamanho > 0 ? 8.0 * c->total_refs / tamanho : 0.0);
+    printf("  Bytes por ref (SVB): %.2f | blocos brutos: %llu bytes\n", refs_svb ? (double) bytes_svb / refs_svb : 0.0,
+           (unsigned long long) bytes_bruto);
+    printf("  Decodificador:      %s\n", traco_nome_decodificador());
+
+    uint64_t amostra[4];
+    size_t n = traco_ler(l, amostra, 4);
+    printf("  Primeiras refs:    ");
+    for (size_t i = 0; i < n; i++) printf(" 0x%llx", (unsigned long long) amostra[i]);
+    printf("\n");
+    traco_fechar(l);
+    return 0;
+}
+
+// =====================
+// TRAÇO SINTÉTICO
+// =====================
+
+static uint64_t rng_traco(uint64_t *estado) {
+    *estado ^= *estado << 13;
+    *estado ^= *estado >> 7;
+    *estado ^= *estado << 17;
+    return *estado;
+}
+
+/**
+ * @brief Mistura padrões típicos: laço de código, varredura de vetor, pilha e saltos para o heap.
+ */
+static int gerar(const char *saida, uint64_t refs, const char *bruto) {
+    EscritorTraco *w = traco_criar(saida, 0);
+    FILE *raw = bruto ? fopen(bruto, "wb") : NULL;
+    if (!w || (bruto && !raw)) {
+        perror("Erro ao criar o traço");
+        if (w) traco_fechar_escrita(w);
+        return 1;
+    }
+
+    const uint64_t codigo = 0x555555554000ull, heap = 0x555555a00000ull, pilha = 0x7ffffffde000ull;
+    const uint64_t mmap_base = 0x7ffff7a00000ull;
+    uint64_t estado = 88172645463325252ull, pc = codigo, vetor = 0, sp = pilha + 0x1f00;
+    std::vector<uint64_t> lote;
+    bool ok = true;
+
+    for (uint64_t i = 0; i < refs && ok; i++) {
+        uint64_t r = rng_traco(&estado), endereco;
+        switch (i % 4) {
+            case 0:   // busca de instrução: laço de 256 bytes com desvios ocasionais
+                pc = (r % 64 == 0) ? codigo + (r >> 20) % 0x40000 : pc + 4;
+                if (pc % 256 == 0) pc -= 256;
+                endereco = pc;
+                break;
+            case 1:   // varredura sequencial de um vetor de 8 bytes
+                endereco = heap + (vetor++ % (1u << 22)) * 8;
+                break;
+            case 2:   // pilha: push/pop em torno do topo
+                sp += (r & 1) ? 8 : -8;
+                endereco = sp;
+                break;
+            default:  // acesso espalhado: heap ou bibliotecas mapeadas
+                endereco = (r % 8 == 0) ? mmap_base + (r >> 16) % (1u << 30) : heap + (r >> 24) % (1u << 26);
+                break;
+        }
+        ok = traco_escrever(w, endereco);
+        if (raw) {
+            lote.push_back(endereco);
+            if (lote.size() == LOTE) {
+                ok = ok && fwrite(lote.data(), sizeof(uint64_t), lote.size(), raw) == lote.size();
+                lote.clear();
+            }
+        }
+    }
+    if (raw) {
+        ok = ok && fwrite(lote.data(), sizeof(uint64_t), lote.size(), raw) == lote.size();
+        ok = fclose(raw) == 0 && ok;
+    }
+    if (!traco_fechar_escrita(w) || !ok) {
+        perror("Erro ao gravar o traço");
+        return 1;
+    }
+    printf("Gerado %s com %llu referências (%lld bytes)\n", saida, (unsigned long long) refs, tamanho_arquivo(saida));
+    if (bruto) printf("Gerado %s (%lld bytes, uint64_t bruto)\n", bruto, tamanho_arquivo(bruto));
+    return 0;
+}
+
+// =====================
+// BENCHMARK
+// =====================
+
+/**
+ * @brief Decodifica todos os blocos já em memória; devolve a soma dos endereços (checagem).
+ */
+static uint64_t decodificar_tudo(const LeitorTraco *l, const std::vector<uint8_t> &comprimido,
+                                 std::vector<uint64_t> &saida, std::vector<uint64_t> &temporario, double *segundos) {
+    uint64_t soma = 0;
+    double inicio = agora();
+    for (uint64_t b = 0; b < l->cab.num_blocos; b++) {
+        const EntradaIndice *e = &l->indice[b];
+        traco_decodificar_bloco(e, comprimido.data() + (e->offset - sizeof(CabecalhoTraco)), saida.data(),
+                                temporario.data());
+        soma += saida[e->quantidade - 1];
+    }
+    *segundos = agora() - inicio;
+    return soma;
+}
+
+static void linha_bench(const char *nome, uint64_t refs, double segundos, double mb_lidos) {
+    printf("%-30s | %10.3f | %10.1f | %10.2f | %9.1f\n", nome, segundos * 1e3, refs / segundos / 1e6,
+           refs * 8.0 / segundos / 1e9, mb_lidos);
+}
+
+static int bench(const char *traco, const char *bruto, double disco_mbs) {
+    LeitorTraco *l = traco_abrir(traco);
+    if (!l) return 1;
+    const CabecalhoTraco *c = &l->cab;
+    uint64_t refs = c->total_refs;
+    if (refs == 0) {
+        printf("Traço vazio.\n");
+        traco_fechar(l);
+        return 0;
+    }
+
+    // Todos os blocos em memória: mede só a decodificação
+    size_t bytes_blocos = (size_t) (c->offset_indice - sizeof(CabecalhoTraco));
+    std::vector<uint8_t> comprimido(bytes_blocos + TRACO_FOLGA, 0);
+    std::vector<uint64_t> saida(c->refs_por_bloco), temporario(c->refs_por_bloco);
+    TRACO_FSEEK(l->arquivo, (long long) sizeof(CabecalhoTraco), SEEK_SET);
+    if (fread(comprimido.data(), 1, bytes_blocos, l->arquivo) != bytes_blocos) {
+        perror("Erro ao ler os blocos");
+        traco_fechar(l);
+        return 1;
+    }
+    for (uint64_t b = 0; b < c->num_blocos; b++) {
+        if (!traco_bloco_valido(&l->indice[b], comprimido.data() + (l->indice[b].offset - sizeof(CabecalhoTraco)))) {
+            fprintf(stderr, "[ERRO] Bloco %llu corrompido\n", (unsigned long long) b);
+            traco_fechar(l);
+            return 1;
+        }
+    }
+
+    printf("============================================================\n");
+    printf("   BENCHMARK DO TRAÇO %s\n", traco);
+    printf("============================================================\n");
+    printf("Referências: %llu | comprimido: %.1f MB | bruto equivalente: %.1f MB (%.1fx)\n\n",
+           (unsigned long long) refs, bytes_blocos / 1e6, refs * 8.0 / 1e6, refs * 8.0 / bytes_blocos);
+    printf("%-30s | %10s | %10s | %10s | %9s\n", "Caminho", "Tempo (ms)", "Mrefs/s", "GB/s bruto", "MB lidos");
+    printf("------------------------------------------------------------------------------------\n");
+
+    double t_escalar, t_simd = 0;
+    traco_forcar_escalar(true);
+    uint64_t soma_escalar = decodificar_tudo(l, comprimido, saida, temporario, &t_escalar);
+    linha_bench("Decodificacao escalar", refs, t_escalar, 0);
+
+    traco_forcar_escalar(false);
+    bool simd = strcmp(traco_nome_decodificador(), "SSE4.1") == 0;
+    if (simd) {
+        uint64_t soma_simd = decodificar_tudo(l, comprimido, saida, temporario, &t_simd);
+        linha_bench("Decodificacao SSE4.1", refs, t_simd, 0);
+        if (soma_simd != soma_escalar) {
+            fprintf(stderr, "[ERRO] Decodificadores divergem (0x%llx x 0x%llx)\n", (unsigned long long) soma_simd,
+                    (unsigned long long) soma_escalar);
+            traco_fechar(l);
+            return 1;
+        }
+    }
+
+    // Leitura em fluxo a partir do arquivo (fread + decodificação), como fazem os simuladores
+    std::vector<uint64_t> lote(LOTE);
+    double inicio = agora();
+    size_t n;
+    while ((n = traco_ler(l, lote.data(), LOTE)) > 0) {}
+    linha_bench("traco_ler() do arquivo", refs, agora() - inicio, bytes_blocos / 1e6);
+
+    double t_bruto = 0;
+    if (bruto) {
+        FILE *f = fopen(bruto, "rb");
+        if (!f) {
+            perror("Erro ao abrir o arquivo bruto");
+        } else {
+            uint64_t lidas = 0;
+            inicio = agora();
+            while ((n = fread(lote.data(), sizeof(uint64_t), LOTE, f)) > 0)
+                lidas += n;
+            t_bruto = agora() - inicio;
+            fclose(f);
+            linha_bench("fread() do bruto", lidas, t_bruto, lidas * 8.0 / 1e6);
+        }
+    }
+    printf("------------------------------------------------------------------------------------\n");
+    if (bruto)
+        printf("Leituras do page cache: rode 'echo 3 > /proc/sys/vm/drop_caches' antes para medir o disco.\n");
+
+    // Modelo de disco: ler bruto x ler comprimido e decodificar (sobrepostos em fluxo)
+    double t_decod = simd ? t_simd : t_escalar;
+    double t_disco_bruto = refs * 8.0 / (disco_mbs * 1e6);
+    double t_disco_comp = bytes_blocos / (disco_mbs * 1e6);
+    double t_comp = t_disco_comp > t_decod ? t_disco_comp : t_decod;
+    printf("\nModelo com disco de %.0f MB/s:\n", disco_mbs);
+    printf("  bruto:       %8.1f ms de leitura\n", t_disco_bruto * 1e3);
+    printf("  comprimido:  %8.1f ms de leitura | %.1f ms de decodificação (%s) → %.1fx mais rápido\n",
+           t_disco_comp * 1e3, t_decod * 1e3, traco_nome_decodificador(), t_disco_bruto / t_comp);
+    printf("  A decodificação só vira gargalo acima de %.1f GB/s de disco.\n", bytes_blocos / t_decod / 1e9);
+
+    traco_fechar(l);
+    return 0;
+}
+
+// =====================
+// MAIN
+// =====================
+
+static void uso(const char *programa) {
+    fprintf(stderr,
+            "Uso:\n"
+            "  %s converter <entrada> <saida.pgt> [--binario] [--hex] [--bloco N]\n"
+            "  %s exportar <traco.pgt> <saida> [--binario]\n"
+            "  %s info <traco.pgt>\n"
+            "  %s gerar <saida.pgt> [refs] [--bruto arquivo.bin]\n"
+            "  %s bench <traco.pgt> [bruto.bin] [--disco MB/s]\n",
+            programa, programa, programa, programa, programa);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        uso(argv[0]);
+        return 1;
+    }
+    const char *cmd = argv[1];
+
+    if (strcmp(cmd, "converter") == 0 && argc >= 4) {
+        const char *bloco = opcao(argc, argv, "--bloco");
+        return converter(argv[2], argv[3], tem_opcao(argc, argv, "--binario"), tem_opcao(argc, argv, "--hex"),
+                         bloco ? (uint32_t) strtoul(bloco, NULL, 10) : 0);
+    }
+    if (strcmp(cmd, "exportar") == 0 && argc >= 4)
+        return exportar(argv[2], argv[3], tem_opcao(argc, argv, "--binario"));
+    if (strcmp(cmd, "info") == 0)
+        return info(argv[2]);
+    if (strcmp(cmd, "gerar") == 0) {
+        uint64_t refs = (argc > 3 && isdigit((unsigned char) argv[3][0])) ? strtoull(argv[3], NULL, 10) : 10000000;
+        return gerar(argv[2], refs, opcao(argc, argv, "--bruto"));
+    }
+    if (strcmp(cmd, "bench") == 0) {
+        const char *bruto = (argc > 3 && argv[3][0] != '-') ? argv[3] : NULL;
+        const char *disco = opcao(argc, argv, "--disco");
+        return bench(argv[2], bruto, disco ? atof(disco) : 500.0);
+    }
+
+    uso(argv[0]);
+    return 1;
+}